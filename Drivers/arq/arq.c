@@ -0,0 +1,392 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<arq.c>
+ *
+ * [MODULE]:		<ARQ>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Source file for the selective-repeat reliable transport over UART>
+ * 					<DATA frame = type, sequence, payload>
+ * 					<ACK frame  = type, next expected sequence, bitmap of frames after it>
+ * 					<Frames travel as COBS packets with CRC-16 (packet driver)>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "timer.h"
+#include "packet.h"
+#include "arq.h"
+
+/* For sharing the window with the ISRs */
+#include <util/atomic.h>
+
+#if ((ARQ_WINDOW_SIZE < 1) || (ARQ_WINDOW_SIZE > 8))
+#error "ARQ_WINDOW_SIZE must be between 1 and 8 to fit the ACK bitmap"
+#endif
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Type and sequence bytes before the payload */
+#define ARQ_HEADER_SIZE 2
+
+/* Packet buffer holds header, payload and the packet CRC */
+#define ARQ_FRAME_SIZE (ARQ_HEADER_SIZE+ARQ_MAX_PAYLOAD+PACKET_CRC_SIZE)
+
+/* Compare value of TIMER0 with F_CPU/1024 for one tick */
+#define ARQ_TICK_COMPARE ((F_CPU/1024UL)*ARQ_TICK_MS/1000UL)
+
+#if (ARQ_TICK_COMPARE < 1) || (ARQ_TICK_COMPARE > 255)
+#error "ARQ_TICK_MS can not be made with TIMER0 at F_CPU/1024"
+#endif
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint8 s_data[ARQ_MAX_PAYLOAD];
+	uint8 s_length;
+	uint8 s_sequence;
+	bool  s_used;
+	volatile bool  s_acked;
+	volatile uint8 s_ticks;		/* Ticks left before the frame is sent again */
+}ARQ_TxSlotType;
+
+typedef struct
+{
+	uint8 s_data[ARQ_MAX_PAYLOAD];
+	uint8 s_length;
+	volatile bool s_valid;
+}ARQ_RxSlotType;
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+/* Send window, slot of a frame is its sequence modulo ARQ_WINDOW_SIZE */
+static ARQ_TxSlotType g_txSlots[ARQ_WINDOW_SIZE];
+static uint8 g_txBase=0;		/* Oldest frame not confirmed */
+static uint8 g_txNext=0;		/* Sequence of next new frame */
+
+/* Receive window, frames kept until the ones before them arrive */
+static ARQ_RxSlotType g_rxSlots[ARQ_WINDOW_SIZE];
+static volatile uint8 g_rxBase=0;	/* Next sequence to deliver */
+static volatile bool g_ackPending=FALSE;
+
+/* Packet decoder buffer, handed back right after each packet */
+static uint8 g_frame[ARQ_FRAME_SIZE];
+
+/* Used to build outgoing frames */
+static uint8 g_txFrame[ARQ_HEADER_SIZE+ARQ_MAX_PAYLOAD];
+
+static void(*g_arq_callBack_Ptr)(const uint8 *a_data_Ptr,uint8 a_length)=NULL_PTR;
+
+static volatile ARQ_StatsType g_stats;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	ARQ_tick
+ *  [Description] :		This function is responsible for counting down the
+ *  					retransmission time of frames in flight, TIMER0 call back
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void ARQ_tick(void){
+	uint8 i;
+
+	for(i=0;i<ARQ_WINDOW_SIZE;i++){
+		if(g_txSlots[i].s_used && !g_txSlots[i].s_acked && g_txSlots[i].s_ticks!=0){
+			g_txSlots[i].s_ticks--;
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	ARQ_handleAck
+ *  [Description] :		This function is responsible for marking frames the ACK
+ *  					confirms, cumulative part and selective bitmap
+ *  [Args] :
+ *  [in]				uint8 a_next:
+ *  						every sequence before it was received
+ *  					uint8 a_bitmap:
+ *  						bit i set when a_next+1+i was received
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void ARQ_handleAck(uint8 a_next,uint8 a_bitmap){
+	uint8 i;
+	uint8 distance;
+
+	for(i=0;i<ARQ_WINDOW_SIZE;i++){
+		if(!g_txSlots[i].s_used || g_txSlots[i].s_acked){
+			continue;
+		}
+		/* Sequence numbers wrap, compare distances modulo 256 */
+		distance=(uint8)(a_next-g_txSlots[i].s_sequence);
+		if(distance!=0 && distance<=128){
+			g_txSlots[i].s_acked=TRUE;
+			continue;
+		}
+		distance=(uint8)(g_txSlots[i].s_sequence-a_next);
+		if(distance>=1 && distance<=8 && (a_bitmap & (1<<(distance-1)))){
+			g_txSlots[i].s_acked=TRUE;
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	ARQ_packetReceived
+ *  [Description] :		This function is responsible for taking a frame out of
+ *  					the packet buffer, runs inside USART_RXC_vect
+ *  [Args] :
+ *  [in]				uint8 *a_packet_Ptr:
+ *  						decoded packet
+ *  					uint8 a_length:
+ *  						packet length
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void ARQ_packetReceived(uint8 *a_packet_Ptr,uint8 a_length){
+	uint8 offset;
+	uint8 i;
+	ARQ_RxSlotType *slot_Ptr;
+
+	if(a_length>=3 && a_packet_Ptr[0]==ARQ_ACK){
+		ARQ_handleAck(a_packet_Ptr[1],a_packet_Ptr[2]);
+	}
+	else if(a_length>=ARQ_HEADER_SIZE && a_packet_Ptr[0]==ARQ_DATA){
+		offset=(uint8)(a_packet_Ptr[1]-g_rxBase);
+		if(offset<ARQ_WINDOW_SIZE){
+			slot_Ptr=&g_rxSlots[a_packet_Ptr[1] % ARQ_WINDOW_SIZE];
+			if(slot_Ptr->s_valid){
+				g_stats.s_duplicates++;
+			}
+			else{
+				slot_Ptr->s_length=a_length-ARQ_HEADER_SIZE;
+				for(i=0;i<slot_Ptr->s_length;i++){
+					slot_Ptr->s_data[i]=a_packet_Ptr[ARQ_HEADER_SIZE+i];
+				}
+				slot_Ptr->s_valid=TRUE;
+			}
+		}
+		else{
+			/* Already delivered, our ACK was lost so send it again */
+			g_stats.s_duplicates++;
+		}
+		g_ackPending=TRUE;
+	}
+
+	/* Same buffer is free again */
+	PACKET_setBuffer(g_frame,ARQ_FRAME_SIZE);
+}
+
+/********************************************************************************
+ *  [Function Name]:	ARQ_sendFrame
+ *  [Description] :		This function is responsible for sending one window slot
+ *  [Args] :
+ *  [in]				ARQ_TxSlotType *a_slot_Ptr:
+ *  						slot to send
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void ARQ_sendFrame(ARQ_TxSlotType *a_slot_Ptr){
+	uint8 i;
+
+	g_txFrame[0]=ARQ_DATA;
+	g_txFrame[1]=a_slot_Ptr->s_sequence;
+	for(i=0;i<a_slot_Ptr->s_length;i++){
+		g_txFrame[ARQ_HEADER_SIZE+i]=a_slot_Ptr->s_data[i];
+	}
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		a_slot_Ptr->s_ticks=ARQ_RETRANSMIT_TICKS;
+	}
+	PACKET_send(g_txFrame,ARQ_HEADER_SIZE+a_slot_Ptr->s_length);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	ARQ_init
+ *  [Description] :		This function is responsible for initializing UART, the
+ *  					packet decoder and the TIMER0 retransmission tick
+ *  [Args] :
+ *  [in]				const UART_ConfigType *a_uart_config_Ptr:
+ *  						UART setting, RX must be INTTERRUPT and TX_BLOCK policy
+ *  					void(*a_receive_callBack_Ptr)(const uint8*,uint8):
+ *  						called from ARQ_poll with frames in order
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void ARQ_init(const UART_ConfigType *a_uart_config_Ptr,void(*a_receive_callBack_Ptr)(const uint8 *a_data_Ptr,uint8 a_length)){
+	Timer_ConfigType tick={TIMER0,CMP,F_CPU_1024,NONE2,NONE_OCO,0,ARQ_TICK_COMPARE,0};
+	uint8 i;
+
+	g_arq_callBack_Ptr=a_receive_callBack_Ptr;
+	g_txBase=0;
+	g_txNext=0;
+	g_rxBase=0;
+	g_ackPending=FALSE;
+	for(i=0;i<ARQ_WINDOW_SIZE;i++){
+		g_txSlots[i].s_used=FALSE;
+		g_rxSlots[i].s_valid=FALSE;
+	}
+
+	UART_init(a_uart_config_Ptr);
+	PACKET_init(g_frame,ARQ_FRAME_SIZE,ARQ_packetReceived);
+
+	TIMER_setCallBack(TIMER0,ARQ_tick);
+	TIMER_init(&tick);
+}
+
+/********************************************************************************
+ *  [Function Name]:	ARQ_send
+ *  [Description] :		This function is responsible for copying one frame into
+ *  					the send window and sending it
+ *  [Args] :
+ *  [in]				const uint8 *a_data_Ptr:
+ *  						payload
+ *  					uint8 a_length:
+ *  						payload length, up to ARQ_MAX_PAYLOAD
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			FALSE when the window is full, call ARQ_poll and try again
+ *********************************************************************************/
+bool ARQ_send(const uint8 *a_data_Ptr,uint8 a_length){
+	ARQ_TxSlotType *slot_Ptr;
+	uint8 i;
+
+	if(a_length>ARQ_MAX_PAYLOAD || (uint8)(g_txNext-g_txBase)>=ARQ_WINDOW_SIZE){
+		return FALSE;
+	}
+
+	slot_Ptr=&g_txSlots[g_txNext % ARQ_WINDOW_SIZE];
+	for(i=0;i<a_length;i++){
+		slot_Ptr->s_data[i]=a_data_Ptr[i];
+	}
+	slot_Ptr->s_length=a_length;
+	slot_Ptr->s_sequence=g_txNext;
+	slot_Ptr->s_acked=FALSE;
+	slot_Ptr->s_used=TRUE;
+	g_txNext++;
+
+	ARQ_sendFrame(slot_Ptr);
+	g_stats.s_sent++;
+	return TRUE;
+}
+
+/********************************************************************************
+ *  [Function Name]:	ARQ_poll
+ *  [Description] :		This function is responsible for delivering frames in
+ *  					order, sending the ACK, sliding the send window and
+ *  					retransmitting timed out frames, call it from main loop
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void ARQ_poll(void){
+	ARQ_RxSlotType *rxSlot_Ptr;
+	ARQ_TxSlotType *txSlot_Ptr;
+	uint8 ack[3];
+	uint8 next;
+	uint8 i;
+
+	/* Deliver frames that are in order */
+	for(;;){
+		rxSlot_Ptr=&g_rxSlots[g_rxBase % ARQ_WINDOW_SIZE];
+		if(!rxSlot_Ptr->s_valid){
+			break;
+		}
+		if(g_arq_callBack_Ptr!=NULL_PTR){
+			(*g_arq_callBack_Ptr)(rxSlot_Ptr->s_data,rxSlot_Ptr->s_length);
+		}
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+			g_stats.s_delivered_bytes+=rxSlot_Ptr->s_length;
+			rxSlot_Ptr->s_valid=FALSE;
+			g_rxBase++;
+		}
+	}
+
+	/* ACK = next expected sequence and which later ones are already here */
+	if(g_ackPending){
+		ack[0]=ARQ_ACK;
+		ack[2]=0;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+			g_ackPending=FALSE;
+			next=g_rxBase;
+			for(i=1;i<ARQ_WINDOW_SIZE;i++){
+				if(g_rxSlots[(uint8)(next+i) % ARQ_WINDOW_SIZE].s_valid){
+					ack[2]|=(1<<(i-1));
+				}
+			}
+		}
+		ack[1]=next;
+		PACKET_send(ack,sizeof(ack));
+	}
+
+	/* Slide the send window over confirmed frames */
+	while(g_txBase!=g_txNext){
+		txSlot_Ptr=&g_txSlots[g_txBase % ARQ_WINDOW_SIZE];
+		if(!txSlot_Ptr->s_acked){
+			break;
+		}
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+			g_stats.s_acked_bytes+=txSlot_Ptr->s_length;
+		}
+		txSlot_Ptr->s_used=FALSE;
+		g_txBase++;
+	}
+
+	/* Send again only the frames whose time ran out */
+	for(i=0;i<ARQ_WINDOW_SIZE;i++){
+		txSlot_Ptr=&g_txSlots[i];
+		if(txSlot_Ptr->s_used && !txSlot_Ptr->s_acked && txSlot_Ptr->s_ticks==0){
+			ARQ_sendFrame(txSlot_Ptr);
+			g_stats.s_retransmits++;
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	ARQ_getStats
+ *  [Description] :		This function is responsible for copying the transport
+ *  					statistics, goodput is s_acked_bytes over the raw bytes
+ *  					the baud rate allows in the same time
+ *  [Args] :
+ *  [in]				None
+ *  [out]				ARQ_StatsType *a_stats_Ptr:
+ *  						pointer to structure the statistics are copied to
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void ARQ_getStats(ARQ_StatsType *a_stats_Ptr){
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		a_stats_Ptr->s_sent=g_stats.s_sent;
+		a_stats_Ptr->s_retransmits=g_stats.s_retransmits;
+		a_stats_Ptr->s_acked_bytes=g_stats.s_acked_bytes;
+		a_stats_Ptr->s_delivered_bytes=g_stats.s_delivered_bytes;
+		a_stats_Ptr->s_duplicates=g_stats.s_duplicates;
+	}
+}
@@ -0,0 +1,74 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<arq.h>
+ *
+ * [MODULE]:		<ARQ>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Header file for the selective-repeat reliable transport over UART>
+ *
+ *******************************************************************************/
+#ifndef ARQ_H_
+#define ARQ_H_
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "uart.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint16 s_sent;				/* Data frames sent the first time */
+	uint16 s_retransmits;		/* Data frames sent again after a timeout */
+	uint32 s_acked_bytes;		/* Payload bytes the other side confirmed */
+	uint32 s_delivered_bytes;	/* Payload bytes given to the receive call back */
+	uint16 s_duplicates;		/* Data frames received twice */
+}ARQ_StatsType;
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Frames that may wait for an ACK at the same time, 1 to 8 */
+#define ARQ_WINDOW_SIZE 4
+
+/* Largest payload of one frame, every window slot keeps a copy */
+#define ARQ_MAX_PAYLOAD 32
+
+/* TIMER0 tick used for retransmission */
+#define ARQ_TICK_MS 10
+
+/* Ticks without an ACK before a frame is sent again */
+#define ARQ_RETRANSMIT_TICKS 20
+
+/* Frame types, first byte of every packet */
+#define ARQ_DATA	0x01
+#define ARQ_ACK		0x02
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/* This function is responsible for initializing UART, the packet layer and TIMER0 */
+void ARQ_init(const UART_ConfigType *a_uart_config_Ptr,void(*a_receive_callBack_Ptr)(const uint8 *a_data_Ptr,uint8 a_length));
+
+/* This function is responsible for putting one frame in the send window */
+bool ARQ_send(const uint8 *a_data_Ptr,uint8 a_length);
+
+/* This function is responsible for delivering data, sending ACKs and retransmitting */
+void ARQ_poll(void);
+
+/* This function is responsible for copying the transport statistics */
+void ARQ_getStats(ARQ_StatsType *a_stats_Ptr);
+
+#endif /* ARQ_H_ */
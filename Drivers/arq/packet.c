@@ -0,0 +1,363 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<packet.c>
+ *
+ * [MODULE]:		<PACKET>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Source file for the COBS framed packet layer over UART>
+ * 					<Frame = COBS(payload + CRC-16 big endian) + 0x00>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "uart.h"
+#include "packet.h"
+
+/* For sharing the buffer and statistics with the ISR */
+#include <util/atomic.h>
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+/* Buffer the next packet is decoded into, NULL_PTR while application owns it */
+static uint8 * volatile g_buffer_Ptr=NULL_PTR;
+
+/* Size of g_buffer_Ptr including the CRC bytes */
+static volatile uint8 g_bufferSize=0;
+
+/* Function called from the ISR when a packet is complete */
+static void(*g_packet_callBack_Ptr)(uint8 *a_packet_Ptr,uint8 a_length)=NULL_PTR;
+
+/* Decoder state, only touched by the UART RX ISR after PACKET_init */
+static uint8 g_index=0;			/* Decoded bytes in current frame */
+static uint8 g_blockCode=0;		/* COBS code of current block, 0 before first block */
+static uint8 g_blockLeft=0;		/* Data bytes left in current block */
+static uint16 g_crc=PACKET_CRC_INIT;
+static bool g_discarding=FALSE;	/* Waiting for next delimiter after an error */
+
+/* Decoder statistics */
+static volatile PACKET_StatsType g_stats;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	PACKET_resetDecoder
+ *  [Description] :		This function is responsible for preparing the decoder
+ *  					for a new frame
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void PACKET_resetDecoder(void){
+	g_index=0;
+	g_blockCode=0;
+	g_blockLeft=0;
+	g_crc=PACKET_CRC_INIT;
+}
+
+/********************************************************************************
+ *  [Function Name]:	PACKET_storeByte
+ *  [Description] :		This function is responsible for writing one decoded byte
+ *  					in the application buffer and adding it to the CRC
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						decoded byte
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			FALSE if the buffer is full
+ *********************************************************************************/
+static bool PACKET_storeByte(uint8 a_data){
+	if(g_index>=g_bufferSize){
+		return FALSE;
+	}
+	g_buffer_Ptr[g_index++]=a_data;
+	g_crc=PACKET_crcUpdate(g_crc,a_data);
+	return TRUE;
+}
+
+/********************************************************************************
+ *  [Function Name]:	PACKET_receiveHandler
+ *  [Description] :		This function is responsible for decoding one byte, it
+ *  					runs inside USART_RXC_vect
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						received byte
+ *  					uint8 a_status:
+ *  						UART error flags of the byte
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void PACKET_receiveHandler(uint8 a_data,uint8 a_status){
+	uint8 *buffer_Ptr;
+
+	if(a_status!=0){
+		/* Corrupted byte, drop the frame and wait for the delimiter */
+		if(!g_discarding){
+			g_stats.s_resyncs++;
+			g_discarding=TRUE;
+		}
+		return;
+	}
+
+	if(a_data==PACKET_DELIMITER){
+		if(g_discarding || g_blockCode==0){
+			/* End of a dropped frame or an idle delimiter */
+		}
+		else if(g_blockLeft!=0 || g_index<PACKET_CRC_SIZE){
+			/* Frame ended inside a block or is too short */
+			g_stats.s_resyncs++;
+		}
+		else if(g_crc!=0){
+			/* CRC over payload and its own CRC must leave zero */
+			g_stats.s_crc_errors++;
+		}
+		else{
+			g_stats.s_packets++;
+
+			/* Hand the buffer to the application until PACKET_setBuffer */
+			buffer_Ptr=g_buffer_Ptr;
+			g_buffer_Ptr=NULL_PTR;
+			if(g_packet_callBack_Ptr!=NULL_PTR){
+				(*g_packet_callBack_Ptr)(buffer_Ptr,g_index-PACKET_CRC_SIZE);
+			}
+		}
+		g_discarding=FALSE;
+		PACKET_resetDecoder();
+		return;
+	}
+
+	if(g_discarding){
+		return;
+	}
+
+	if(g_blockCode==0 && g_buffer_Ptr==NULL_PTR){
+		/* Application still owns the last packet */
+		g_stats.s_busy_drops++;
+		g_discarding=TRUE;
+		return;
+	}
+
+	if(g_blockLeft==0){
+		/* Code byte, a block shorter than 254 bytes ended with a zero */
+		if(g_blockCode!=0 && g_blockCode!=0xFF && !PACKET_storeByte(0)){
+			g_stats.s_resyncs++;
+			g_discarding=TRUE;
+			return;
+		}
+		g_blockCode=a_data;
+		g_blockLeft=a_data-1;
+	}
+	else{
+		if(!PACKET_storeByte(a_data)){
+			g_stats.s_resyncs++;
+			g_discarding=TRUE;
+			return;
+		}
+		g_blockLeft--;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	PACKET_sendRun
+ *  [Description] :		This function is responsible for queuing bytes of the
+ *  					virtual frame (payload then CRC) from index a_start
+ *  [Args] :
+ *  [in]				const uint8 *a_data_Ptr:
+ *  						payload
+ *  					uint8 a_length:
+ *  						payload length
+ *  					const uint8 *a_crc_Ptr:
+ *  						CRC bytes, high byte first
+ *  					uint16 a_start:
+ *  						index of first byte
+ *  					uint8 a_count:
+ *  						number of bytes
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void PACKET_sendRun(const uint8 *a_data_Ptr,uint8 a_length,const uint8 *a_crc_Ptr,uint16 a_start,uint8 a_count){
+	uint8 part;
+
+	if(a_start<a_length){
+		/* Payload part goes in one UART_write */
+		part=((a_length-a_start)<a_count)?(a_length-a_start):a_count;
+		UART_write(a_data_Ptr+a_start,part);
+		a_start+=part;
+		a_count-=part;
+	}
+	if(a_count!=0){
+		UART_write(a_crc_Ptr+(a_start-a_length),a_count);
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	PACKET_init
+ *  [Description] :		This function is responsible for starting the packet
+ *  					decoder, UART must be initialized with RX interrupt
+ *  [Args] :
+ *  [in]				uint8 *a_buffer_Ptr:
+ *  						buffer the first packet is decoded into
+ *  					uint8 a_size:
+ *  						buffer size, payload plus PACKET_CRC_SIZE bytes
+ *  					void(*a_callBack_Ptr)(uint8*,uint8):
+ *  						called from the ISR with the filled buffer and
+ *  						the payload length
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void PACKET_init(uint8 *a_buffer_Ptr,uint8 a_size,void(*a_callBack_Ptr)(uint8 *a_packet_Ptr,uint8 a_length)){
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		g_packet_callBack_Ptr=a_callBack_Ptr;
+		g_buffer_Ptr=a_buffer_Ptr;
+		g_bufferSize=a_size;
+		g_discarding=FALSE;
+		PACKET_resetDecoder();
+		g_stats.s_packets=0;
+		g_stats.s_crc_errors=0;
+		g_stats.s_resyncs=0;
+		g_stats.s_busy_drops=0;
+	}
+
+	/* Decode straight from USART_RXC_vect */
+	UART_setReceiveHandler(PACKET_receiveHandler);
+}
+
+/********************************************************************************
+ *  [Function Name]:	PACKET_setBuffer
+ *  [Description] :		This function is responsible for giving the decoder a
+ *  					buffer after a packet was delivered, may be called from
+ *  					the packet call back to swap buffers
+ *  [Args] :
+ *  [in]				uint8 *a_buffer_Ptr:
+ *  						buffer the next packet is decoded into
+ *  					uint8 a_size:
+ *  						buffer size, payload plus PACKET_CRC_SIZE bytes
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void PACKET_setBuffer(uint8 *a_buffer_Ptr,uint8 a_size){
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		g_bufferSize=a_size;
+		g_buffer_Ptr=a_buffer_Ptr;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	PACKET_send
+ *  [Description] :		This function is responsible for COBS encoding payload
+ *  					and CRC into the UART transmit buffer, use the TX_BLOCK
+ *  					policy so frames are never cut
+ *  [Args] :
+ *  [in]				const uint8 *a_data_Ptr:
+ *  						payload
+ *  					uint8 a_length:
+ *  						payload length, up to PACKET_MAX_PAYLOAD
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void PACKET_send(const uint8 *a_data_Ptr,uint8 a_length){
+	uint8 crc[PACKET_CRC_SIZE];
+	uint16 crcValue=PACKET_CRC_INIT;
+	uint16 total;
+	uint16 i;
+	uint8 run;
+	uint8 code;
+	uint8 delimiter=PACKET_DELIMITER;
+
+	if(a_length>PACKET_MAX_PAYLOAD){
+		return;
+	}
+
+	for(i=0;i<a_length;i++){
+		crcValue=PACKET_crcUpdate(crcValue,a_data_Ptr[i]);
+	}
+	crc[0]=(uint8)(crcValue>>8);
+	crc[1]=(uint8)crcValue;
+	total=a_length+PACKET_CRC_SIZE;
+
+	i=0;
+	for(;;){
+		/* Count non zero bytes of this block, 254 at most */
+		run=0;
+		while((i+run)<total && run<254 &&
+			  (((i+run)<a_length)?a_data_Ptr[i+run]:crc[i+run-a_length])!=0){
+			run++;
+		}
+		code=run+1;
+		UART_write(&code,1);
+		PACKET_sendRun(a_data_Ptr,a_length,crc,i,run);
+		i+=run;
+		if(i>=total){
+			break;
+		}
+		if(run<254){
+			/* Skip the zero this block stands for */
+			i++;
+		}
+	}
+	UART_write(&delimiter,1);
+}
+
+/********************************************************************************
+ *  [Function Name]:	PACKET_getStats
+ *  [Description] :		This function is responsible for copying the decoder
+ *  					statistics
+ *  [Args] :
+ *  [in]				None
+ *  [out]				PACKET_StatsType *a_stats_Ptr:
+ *  						pointer to structure the statistics are copied to
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void PACKET_getStats(PACKET_StatsType *a_stats_Ptr){
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		a_stats_Ptr->s_packets=g_stats.s_packets;
+		a_stats_Ptr->s_crc_errors=g_stats.s_crc_errors;
+		a_stats_Ptr->s_resyncs=g_stats.s_resyncs;
+		a_stats_Ptr->s_busy_drops=g_stats.s_busy_drops;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	PACKET_crcUpdate
+ *  [Description] :		This function is responsible for updating CRC-16/CCITT
+ *  					(polynomial 0x1021, not reflected) with one byte
+ *  					without a table
+ *  [Args] :
+ *  [in]				uint16 a_crc:
+ *  						current CRC
+ *  					uint8 a_data:
+ *  						new byte
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Updated CRC
+ *********************************************************************************/
+uint16 PACKET_crcUpdate(uint16 a_crc,uint8 a_data){
+	a_crc=(uint8)(a_crc>>8) | (a_crc<<8);
+	a_crc^=a_data;
+	a_crc^=(uint8)(a_crc & 0xFF)>>4;
+	a_crc^=(a_crc<<8)<<4;
+	a_crc^=((a_crc & 0xFF)<<4)<<1;
+	return a_crc;
+}
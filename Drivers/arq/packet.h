@@ -0,0 +1,71 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<packet.h>
+ *
+ * [MODULE]:		<PACKET>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Header file for the COBS framed packet layer over UART>
+ *
+ *******************************************************************************/
+#ifndef PACKET_H_
+#define PACKET_H_
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint16 s_packets;		/* Packets delivered with a good CRC */
+	uint16 s_crc_errors;	/* Complete frames dropped for a bad CRC */
+	uint16 s_resyncs;		/* Frames dropped for UART errors, bad COBS or overflow */
+	uint16 s_busy_drops;	/* Frames dropped while no buffer was given */
+}PACKET_StatsType;
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Byte that ends every frame on the line */
+#define PACKET_DELIMITER 0x00
+
+/* CRC-16/CCITT (polynomial 0x1021) start value */
+#define PACKET_CRC_INIT 0xFFFF
+
+/* Number of CRC bytes sent after the payload */
+#define PACKET_CRC_SIZE 2
+
+/* Largest payload, decoded frame length must fit in uint8 */
+#define PACKET_MAX_PAYLOAD (255-PACKET_CRC_SIZE)
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/* This function is responsible for starting the packet decoder on the UART RX ISR */
+void PACKET_init(uint8 *a_buffer_Ptr,uint8 a_size,void(*a_callBack_Ptr)(uint8 *a_packet_Ptr,uint8 a_length));
+
+/* This function is responsible for giving the decoder a buffer for the next packet */
+void PACKET_setBuffer(uint8 *a_buffer_Ptr,uint8 a_size);
+
+/* This function is responsible for sending one framed packet */
+void PACKET_send(const uint8 *a_data_Ptr,uint8 a_length);
+
+/* This function is responsible for copying the decoder statistics */
+void PACKET_getStats(PACKET_StatsType *a_stats_Ptr);
+
+/* This function is responsible for updating CRC-16/CCITT with one byte */
+uint16 PACKET_crcUpdate(uint16 a_crc,uint8 a_data);
+
+#endif /* PACKET_H_ */
@@ -0,0 +1,1082 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<uart.c>
+ *
+ * [MODULE]:		<UART>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<11/8/2020>
+ *
+ * [DESCRIPTION]:	<Source file for the UART driver>
+ * 					<Asynchronous , 1 stop bit and 8 data bits transfer >
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "uart.h"
+
+/* For reading counters shared with the ISR */
+#include <util/atomic.h>
+
+#if ((UART_TX_BUFFER_SIZE < 2) || (UART_TX_BUFFER_SIZE > 256) || \
+	 (UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1)))
+#error "UART_TX_BUFFER_SIZE must be a power of two between 2 and 256"
+#endif
+
+#if ((UART_RX_BUFFER_SIZE < 2) || (UART_RX_BUFFER_SIZE > 256) || \
+	 (UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE - 1)))
+#error "UART_RX_BUFFER_SIZE must be a power of two between 2 and 256"
+#endif
+
+/* Mask used to wrap the transmit buffer indices */
+#define UART_TX_MASK (UART_TX_BUFFER_SIZE - 1)
+
+/* Mask used to wrap the receive buffer indices */
+#define UART_RX_MASK (UART_RX_BUFFER_SIZE - 1)
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+/* Global pointer to store address of initialization structure */
+static const UART_ConfigType *g_config_Ptr=0;
+
+/* Global variable used for call back technique */
+
+static void(*g_uartTX_Ptr)(void);
+
+static void(*g_uartRX_Ptr)(void);
+
+static void(*g_uartTXC_Ptr)(void);
+
+/* Transmit ring buffer, filled by UART_write and drained by USART_UDRE_vect */
+static uint8 g_txBuffer[UART_TX_BUFFER_SIZE];
+
+/* Index of next free slot, written only by UART_write */
+static volatile uint8 g_txHead=0;
+
+/* Index of next byte to send, written only by USART_UDRE_vect */
+static volatile uint8 g_txTail=0;
+
+/* Policy used when the transmit buffer is full */
+static UART_TxPolicy g_txPolicy=TX_BLOCK;
+
+/* Highest number of bytes waiting in the transmit buffer */
+static uint8 g_txHighWater=0;
+
+/* Number of bytes refused because the transmit buffer was full */
+static uint16 g_txDropped=0;
+
+/* Receive ring buffer, filled by USART_RXC_vect and emptied by UART_read */
+static uint8 g_rxBuffer[UART_RX_BUFFER_SIZE];
+
+/* Index of next free slot, written only by USART_RXC_vect */
+static volatile uint8 g_rxHead=0;
+
+/* Index of next byte to read, written only by the application side */
+static volatile uint8 g_rxTail=0;
+
+/* Error flags of each byte in g_rxBuffer */
+static uint8 g_rxStatus[UART_RX_BUFFER_SIZE];
+
+/* Set when a byte was dropped, given to the next stored byte */
+static uint8 g_rxLost=0;
+
+/* Flow control character the UDRE ISR sends before buffered data, 0 for none */
+static volatile uint8 g_flowChar=0;
+
+/* TRUE after XOFF was received */
+static volatile bool g_txPaused=FALSE;
+
+/* TRUE after we asked the other side to stop */
+static volatile bool g_rxThrottled=FALSE;
+
+/* Receive error counters, written only by USART_RXC_vect */
+static volatile UART_ErrorCountersType g_rxErrors;
+
+/* Baud rate error of the last UART_init in per-mille */
+static uint16 g_baudError=0;
+
+#if (UART_AUTOBAUD==1)
+/* Standard rates UART_autoBaud snaps to */
+static const uint32 g_standardRates[]={
+	1200,2400,4800,9600,14400,19200,28800,38400,57600,76800,115200,230400,250000
+};
+#endif
+
+/* Upper layer handler that takes received bytes instead of the receive buffer */
+static void(*g_uartRxHandler_Ptr)(uint8 a_data,uint8 a_status)=NULL_PTR;
+
+/*******************************************************************************
+ *                      Private Functions Prototypes                           *
+ *******************************************************************************/
+
+static void UART_countErrors(uint8 a_status);
+static void UART_rxResume(void);
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+/* ISR activated after data is transmitted */
+ISR(USART_UDRE_vect){
+	uint8 tail=g_txTail;
+
+	if(g_flowChar!=0){
+		/* XON or XOFF goes before any queued byte */
+		UDR=g_flowChar;
+		g_flowChar=0;
+	}
+	else if(g_txPaused || (g_config_Ptr->s_flow_control==RTS_CTS && BIT_IS_SET(UART_CTS_IN,UART_CTS_PIN))){
+		/* Other side is full, XON or UART_ctsChanged restarts the interrupt */
+		CLEAR_BIT(UCSRB,UDRIE);
+	}
+	else if(tail!=g_txHead){
+		/* Send next byte from the transmit buffer */
+		UDR=g_txBuffer[tail];
+		g_txTail=(tail+1) & UART_TX_MASK;
+	}
+	else if(g_uartTX_Ptr!=NULL_PTR){
+		/* Call the function in the Scheduler using Call Back concept */
+		(*g_uartTX_Ptr)();
+	}
+	else{
+		/* Nothing left to send so stop the interrupt until next UART_write */
+		CLEAR_BIT(UCSRB,UDRIE);
+	}
+}
+
+/* ISR activated after last byte left the shift register */
+ISR(USART_TXC_vect){
+	if(g_uartTXC_Ptr!=NULL_PTR){
+		/* Call the function in the Scheduler using Call Back concept */
+		(*g_uartTXC_Ptr)();
+	}
+}
+
+/* ISR activated after data is received */
+ISR(USART_RXC_vect){
+	/* Error flags and 9th bit belong to the byte in UDR so read them before UDR */
+	uint8 status=UCSRA & UART_RX_ERROR_MASK;
+	uint8 data;
+	uint8 head;
+	uint8 next;
+
+	if(BIT_IS_SET(UCSRB,RXB8)){
+		status|=UART_RX_BIT9;
+	}
+	data=UDR;
+
+	if(g_config_Ptr->s_mpcm && (status & UART_RX_BIT9)){
+		/* Address frame, take data frames only while we are addressed
+		 * U2X kept, TXC written 0 so it is not cleared */
+		if(data==g_config_Ptr->s_address){
+			UCSRA&=(1<<U2X);
+		}
+		else{
+			UCSRA=(UCSRA & (1<<U2X)) | (1<<MPCM);
+		}
+		return;
+	}
+
+	if(status & UART_RX_ERROR_MASK){
+		UART_countErrors(status);
+	}
+
+	if(g_config_Ptr->s_flow_control==XON_XOFF && (data==UART_XON || data==UART_XOFF)){
+		/* Flow control characters are not data */
+		g_txPaused=(data==UART_XOFF);
+		if(!g_txPaused){
+			SET_BIT(UCSRB,UDRIE);
+		}
+		return;
+	}
+
+	if(g_uartRxHandler_Ptr!=NULL_PTR){
+		/* Upper layer consumes the raw byte and its error flags */
+		(*g_uartRxHandler_Ptr)(data,status);
+		return;
+	}
+
+	head=g_rxHead;
+	next=(head+1) & UART_RX_MASK;
+	if(next!=g_rxTail){
+		/* Store the raw byte with its flags then publish it */
+		g_rxBuffer[head]=data;
+		g_rxStatus[head]=(status & (UART_RX_ERROR_MASK|UART_RX_BIT9)) | g_rxLost;
+		g_rxLost=0;
+		g_rxHead=next;
+
+		if(!g_rxThrottled && ((next-g_rxTail) & UART_RX_MASK)>=UART_RX_HIGH_WATER){
+			/* Buffer nearly full, stop the other side */
+			if(g_config_Ptr->s_flow_control==XON_XOFF){
+				g_rxThrottled=TRUE;
+				g_flowChar=UART_XOFF;
+				SET_BIT(UCSRB,UDRIE);
+			}
+			else if(g_config_Ptr->s_flow_control==RTS_CTS){
+				g_rxThrottled=TRUE;
+				SET_BIT(UART_RTS_PORT,UART_RTS_PIN);
+			}
+		}
+	}
+	else{
+		/* Application is not reading fast enough, flag the next stored byte */
+		g_rxErrors.s_buffer_overflows++;
+		g_rxLost=UART_RX_OVERFLOW;
+	}
+
+	if(g_uartRX_Ptr!=NULL_PTR){
+		/* Call the function in the Scheduler using Call Back concept */
+		(*g_uartRX_Ptr)();
+	}
+}
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	UART_countErrors
+ *  [Description] :		This function is responsible for adding the error flags
+ *  					of one received byte to the counters
+ *  [Args] :
+ *  [in]				uint8 a_status:
+ *  						UCSRA flags of the byte
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void UART_countErrors(uint8 a_status){
+	if(BIT_IS_SET(a_status,DOR)){
+		g_rxErrors.s_data_overruns++;
+	}
+	if(BIT_IS_SET(a_status,FE)){
+		g_rxErrors.s_frame_errors++;
+	}
+	if(BIT_IS_SET(a_status,PE)){
+		g_rxErrors.s_parity_errors++;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_rxResume
+ *  [Description] :		This function is responsible for restarting the other
+ *  					side once the receive buffer drained to the low water
+ *  					mark, called after every read from the buffer
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void UART_rxResume(void){
+	if(!g_rxThrottled){
+		return;
+	}
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		if(((g_rxHead-g_rxTail) & UART_RX_MASK)<=UART_RX_LOW_WATER){
+			g_rxThrottled=FALSE;
+			if(g_config_Ptr->s_flow_control==XON_XOFF){
+				g_flowChar=UART_XON;
+				SET_BIT(UCSRB,UDRIE);
+			}
+			else{
+				CLEAR_BIT(UART_RTS_PORT,UART_RTS_PIN);
+			}
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_writeDirect
+ *  [Description] :		This function is responsible for writing one frame
+ *  					straight to UDR once the transmit buffer and any XON or
+ *  					XOFF went out, checked and written with interrupts held
+ *  					off so USART_UDRE_vect can not load UDR in between
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						byte to send
+ *  					bool a_address:
+ *  						TRUE sends the frame with the 9th bit set
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void UART_writeDirect(uint8 a_data,bool a_address){
+	bool sent=FALSE;
+
+	while(!sent){
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+			/* Queued bytes go first to keep the order, then wait while the other side asked us to stop */
+			if(g_txHead==g_txTail && g_flowChar==0 && !g_txPaused && BIT_IS_SET(UCSRA,UDRE) &&
+					!(g_config_Ptr->s_flow_control==RTS_CTS && BIT_IS_SET(UART_CTS_IN,UART_CTS_PIN))){
+				if(a_address){
+					/* TXB8 must be set before UDR is written */
+					SET_BIT(UCSRB,TXB8);
+					UDR=a_data;
+
+					/* Once UDR is empty the address moved to the shift register with its 9th bit,
+					 * still inside the block so no XON or XOFF is sent as an address */
+					while(BIT_IS_CLEAR(UCSRA,UDRE));
+					CLEAR_BIT(UCSRB,TXB8);
+				}
+				else{
+					UDR=a_data;
+				}
+				sent=TRUE;
+			}
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_baudError
+ *  [Description] :		This function is responsible for calculating UBRR for one
+ *  					divider and the baud rate error it gives
+ *  [Args] :
+ *  [in]				uint32 a_baudRate:
+ *  						required baud rate
+ *  					uint8 a_divider:
+ *  						16 for normal speed or 8 for double speed
+ *  [out]				uint16 *a_ubrr_Ptr:
+ *  						calculated UBRR value
+ *  [in/out]			None
+ *  [Returns]			Baud rate error in per-mille
+ *********************************************************************************/
+static uint32 UART_baudError(uint32 a_baudRate,uint8 a_divider,uint16 *a_ubrr_Ptr){
+	uint32 step=a_baudRate*a_divider;
+	uint32 ubrr=(F_CPU+(step>>1))/step;
+	uint32 real;
+
+	if(ubrr==0 || ubrr>4096){
+		/* Rate can not be generated with this divider */
+		*a_ubrr_Ptr=0;
+		return 0xFFFFFFFF;
+	}
+	real=F_CPU/((uint32)a_divider*ubrr);
+	*a_ubrr_Ptr=ubrr-1;
+	return ((real>a_baudRate)?(real-a_baudRate):(a_baudRate-real))*1000UL/a_baudRate;
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_setBaudRate
+ *  [Description] :		This function is responsible for setting UBRR and U2X at
+ *  					run time, choosing the divider with smaller error
+ *  [Args] :
+ *  [in]				uint32 a_baudRate:
+ *  						required baud rate
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Baud rate error in per-mille
+ *********************************************************************************/
+static uint32 UART_setBaudRate(uint32 a_baudRate){
+	uint16 ubrrNormal;
+	uint16 ubrrDouble;
+	uint32 errorNormal=UART_baudError(a_baudRate,16,&ubrrNormal);
+	uint32 errorDouble=UART_baudError(a_baudRate,8,&ubrrDouble);
+
+	if(errorDouble<errorNormal){
+		SET_BIT(UCSRA,U2X);
+		ubrrNormal=ubrrDouble;
+		errorNormal=errorDouble;
+	}
+	else{
+		CLEAR_BIT(UCSRA,U2X);
+	}
+
+	/* First 8 bits inside UBRRL and last 4 bits in UBRRH, URSEL=0 to write in UBRRH */
+	UBRRH = (uint8)(ubrrNormal>>8);
+	UBRRL = (uint8)ubrrNormal;
+	return errorNormal;
+}
+
+#if (UART_AUTOBAUD==1)
+/********************************************************************************
+ *  [Function Name]:	UART_waitCapture
+ *  [Description] :		This function is responsible for waiting one TIMER1
+ *  					input capture edge, counting overflows for the timeout
+ *  [Args] :
+ *  [in]				None
+ *  [out]				uint16 *a_time_Ptr:
+ *  						captured TCNT1 value
+ *  [in/out]			uint16 *a_overflows_Ptr:
+ *  						overflows left before timeout
+ *  [Returns]			FALSE on timeout
+ *********************************************************************************/
+static bool UART_waitCapture(uint16 *a_time_Ptr,uint16 *a_overflows_Ptr){
+	while(BIT_IS_CLEAR(TIFR,ICF1)){
+		if(BIT_IS_SET(TIFR,TOV1)){
+			TIFR=(1<<TOV1);
+			if(*a_overflows_Ptr==0){
+				return FALSE;
+			}
+			(*a_overflows_Ptr)--;
+		}
+	}
+	*a_time_Ptr=ICR1;
+
+	/* Next edge is the opposite one, flag must be cleared after changing ICES1 */
+	TOGGLE_BIT(TCCR1B,ICES1);
+	TIFR=(1<<ICF1);
+	return TRUE;
+}
+#endif
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	UART_init
+ *  [Description] :		This function is responsible for initializing the UART
+ *  [Args] :
+ *  [in]				const UART_ConfigType *a_config_Ptr:
+ *  							pointer contains address of structure
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void UART_init(const UART_ConfigType *a_config_Ptr){
+	uint8 ucsrc;
+
+	/* Storing pointer in global one */
+	g_config_Ptr=a_config_Ptr;
+
+	/* Start with an empty transmit buffer */
+	g_txHead=0;
+	g_txTail=0;
+	g_txPolicy=a_config_Ptr->s_tx_policy;
+
+	/* Start with an empty receive buffer */
+	g_rxHead=0;
+	g_rxLost=0;
+	g_rxTail=0;
+
+	/* Both sides start ready */
+	g_flowChar=0;
+	g_txPaused=FALSE;
+	g_rxThrottled=FALSE;
+	if(a_config_Ptr->s_flow_control==RTS_CTS){
+		CLEAR_BIT(UART_RTS_PORT,UART_RTS_PIN);
+		SET_BIT(UART_RTS_DIR,UART_RTS_PIN);
+		/* Pull-up keeps CTS deasserted when nothing is connected */
+		CLEAR_BIT(UART_CTS_DIR,UART_CTS_PIN);
+		SET_BIT(UART_CTS_PORT,UART_CTS_PIN);
+	}
+
+	if(a_config_Ptr->s_tx_mode)
+		/* Enable interrupt mode with transmitting data */
+		SET_BIT(UCSRB,UDRIE);
+
+	if(a_config_Ptr->s_rx_mode)
+		/* Enable interrupt mode with receiving data */
+		SET_BIT(UCSRB,RXCIE);
+
+	/* UCSRC shares its address with UBRRH and can not be read back safely
+	 * so build the value first then write it once with URSEL=1 */
+	ucsrc=(1<<URSEL);
+
+	/* Choose Parity */
+	switch(a_config_Ptr->s_parity){
+
+	case NO_PARITY:
+		/*Disable Parity  */
+		break;
+
+	case EVEN_PARITY:
+		/* Enable even parity */
+		ucsrc|=(1<<UPM1);
+		break;
+
+	case ODD_PARITY:
+		/* Enable odd parity */
+		ucsrc|=(1<<UPM0) | (1<<UPM1);
+		break;
+	}
+
+	/* Number of data bits, 9 bits also needs UCSZ2 */
+	ucsrc|=(a_config_Ptr->s_word_bits) & ((1<<UCSZ1) | (1<<UCSZ0));
+	UCSRC=ucsrc;
+	if(a_config_Ptr->s_word_bits==W9_BITS){
+		SET_BIT(UCSRB,UCSZ2);
+	}
+	else{
+		CLEAR_BIT(UCSRB,UCSZ2);
+	}
+
+	/* Multi-processor mode ignores data frames until our address is received */
+	UCSRA=(a_config_Ptr->s_mpcm)?(1<<MPCM):0;
+
+	if(a_config_Ptr->s_baudRate==UART_BAUD_RATE){
+		/* Use the values calculated at compile time, no division needed */
+#if (UART_U2X_VALUE==1)
+		SET_BIT(UCSRA,U2X);
+#else
+		CLEAR_BIT(UCSRA,U2X);
+#endif
+		/* First 8 bits inside UBRRL and last 4 bits in UBRRH, URSEL=0 to write in UBRRH */
+		UBRRH = UART_UBRRH_VALUE;
+		UBRRL = UART_UBRRL_VALUE;
+		g_baudError=UART_BAUD_ERROR_VALUE;
+	}
+	else{
+		/* Baud rate not known at compile time */
+		g_baudError=(uint16)UART_setBaudRate(a_config_Ptr->s_baudRate);
+	}
+
+	/* Enable Receiving and Transmitting keeping interrupt enables set above */
+	UCSRB|= (1<<RXEN) | (1<<TXEN);
+}
+/********************************************************************************
+ *  [Function Name]:	UART_sendByte
+ *  [Description] :		This function is responsible for sending one byte
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						contain data that will be sent
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void UART_sendByte(uint8 a_data){
+	/* Transmit data after the transmit buffer, never at the same time as the ISR */
+	UART_writeDirect(a_data,FALSE);
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_receiveByte
+ *  [Description] :		This function is responsible for receiving one byte
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			The received data.
+ *********************************************************************************/
+uint8 UART_receiveByte(void){
+	uint8 status;
+	uint8 data=UART_receiveByteStatus(&status);
+
+	/* Check for parity or frame error */
+	if(status & ((1<<FE)|(1<<PE))){
+		/* return safe character chosen */
+		return (g_config_Ptr->s_safeChar);
+	}
+
+	/* Return received data */
+	return data;
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_receiveByteStatus
+ *  [Description] :		This function is responsible for receiving one byte as
+ *  					it arrived on the line with its status flags, the 9th
+ *  					bit of W9_BITS frames comes as UART_RX_BIT9
+ *  					Works with polling and interrupt receive modes
+ *  [Args] :
+ *  [in]				None
+ *  [out]				uint8 *a_status_Ptr:
+ *  						UART_RX_ERROR_MASK, UART_RX_OVERFLOW and UART_RX_BIT9
+ *  						flags of the byte
+ *  [in/out]			None
+ *  [Returns]			The received data, not replaced when corrupted
+ *********************************************************************************/
+uint8 UART_receiveByteStatus(uint8 *a_status_Ptr){
+	uint8 data;
+	uint8 status;
+	uint8 tail;
+
+	if(g_config_Ptr->s_rx_mode==INTTERRUPT){
+		/* Wait for USART_RXC_vect to store the byte */
+		while(g_rxHead==g_rxTail);
+		tail=g_rxTail;
+		data=g_rxBuffer[tail];
+		*a_status_Ptr=g_rxStatus[tail];
+		g_rxTail=(tail+1) & UART_RX_MASK;
+		UART_rxResume();
+		return data;
+	}
+
+	/* Wait until current receiving is finished */
+	while(BIT_IS_CLEAR(UCSRA,RXC));
+
+	/* Flags and 9th bit must be read before UDR, UDR is always read to free
+	 * the receiver */
+	status=UCSRA & UART_RX_ERROR_MASK;
+	if(BIT_IS_SET(UCSRB,RXB8)){
+		status|=UART_RX_BIT9;
+	}
+	data=UDR;
+	if(status & UART_RX_ERROR_MASK){
+		UART_countErrors(status);
+	}
+	*a_status_Ptr=status;
+	return data;
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_sendString
+ *  [Description] :		This function is responsible for sending String
+ *  [Args] :
+ *  [in]				uint8 *a_str_Ptr:
+ *  						contain address of data that will be sent
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void UART_sendString(uint8 *a_str_Ptr){
+	while(*a_str_Ptr!='\0'){
+		UART_sendByte(*a_str_Ptr);
+		a_str_Ptr++;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_receiveString
+ *  [Description] :		This function is responsible for receiving String
+ *  [Args] :
+ *  [in]				uint8 *a_str_Ptr:
+ *  						pointer to address that data will be stored at
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None.
+ *********************************************************************************/
+void UART_receiveString(uint8 *a_str_Ptr){
+	uint8 numberofchars;
+	numberofchars=UART_receiveByte();
+	for(;numberofchars>0;numberofchars--){
+		*a_str_Ptr=UART_receiveByte();
+		a_str_Ptr++;
+	}
+	*a_str_Ptr='\0';
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_write
+ *  [Description] :		This function is responsible for queuing bytes in the
+ *  					transmit buffer, USART_UDRE_vect sends them in background
+ *  					If buffer is full the configured s_tx_policy is applied:
+ *  					TX_BLOCK       wait until the ISR makes room
+ *  					TX_DROP        queue nothing unless all bytes fit
+ *  					TX_SHORT_COUNT queue what fits and return that count
+ *  					TX_BLOCK needs global interrupts to be enabled
+ *  [Args] :
+ *  [in]				const uint8 *a_data_Ptr:
+ *  						contain address of data that will be sent
+ *  					uint16 a_length:
+ *  						number of bytes to send
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Number of bytes queued
+ *********************************************************************************/
+uint16 UART_write(const uint8 *a_data_Ptr,uint16 a_length){
+	uint16 queued=0;
+	uint8 head=g_txHead;
+	uint8 used;
+
+	if(g_txPolicy==TX_DROP){
+		/* All or nothing so a message is never sent partially */
+		used=(head-g_txTail) & UART_TX_MASK;
+		if(a_length>(uint16)(UART_TX_MASK-used)){
+			g_txDropped+=a_length;
+			return 0;
+		}
+	}
+
+	while(queued<a_length){
+		if(((head+1) & UART_TX_MASK)==g_txTail){
+			if(g_txPolicy!=TX_BLOCK){
+				/* Buffer is full, remaining bytes are refused */
+				g_txDropped+=a_length-queued;
+				break;
+			}
+			/* Wait until the ISR frees one slot */
+			continue;
+		}
+		g_txBuffer[head]=a_data_Ptr[queued];
+		head=(head+1) & UART_TX_MASK;
+		queued++;
+
+		/* Publish the byte then make sure the ISR is running */
+		g_txHead=head;
+		SET_BIT(UCSRB,UDRIE);
+
+		used=(head-g_txTail) & UART_TX_MASK;
+		if(used>g_txHighWater){
+			g_txHighWater=used;
+		}
+	}
+	return queued;
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_writeString
+ *  [Description] :		This function is responsible for queuing String in the
+ *  					transmit buffer using UART_write
+ *  [Args] :
+ *  [in]				const uint8 *a_str_Ptr:
+ *  						contain address of the null terminated string
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Number of bytes queued
+ *********************************************************************************/
+uint16 UART_writeString(const uint8 *a_str_Ptr){
+	uint16 length=0;
+
+	while(a_str_Ptr[length]!='\0'){
+		length++;
+	}
+	return UART_write(a_str_Ptr,length);
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_getTxHighWaterMark
+ *  [Description] :		This function is responsible for returning the highest
+ *  					number of bytes that waited in the transmit buffer
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Transmit buffer high-water mark
+ *********************************************************************************/
+uint8 UART_getTxHighWaterMark(void){
+	return g_txHighWater;
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_getTxDropCount
+ *  [Description] :		This function is responsible for returning the number of
+ *  					bytes UART_write refused because the buffer was full
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Number of dropped bytes
+ *********************************************************************************/
+uint16 UART_getTxDropCount(void){
+	return g_txDropped;
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_available
+ *  [Description] :		This function is responsible for returning number of
+ *  					bytes USART_RXC_vect stored in the receive buffer
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Number of bytes ready to be read
+ *********************************************************************************/
+uint8 UART_available(void){
+	return (g_rxHead-g_rxTail) & UART_RX_MASK;
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_read
+ *  [Description] :		This function is responsible for taking up to a_length
+ *  					bytes out of the receive buffer without waiting
+ *  [Args] :
+ *  [in]				uint8 a_length:
+ *  						maximum number of bytes to read
+ *  [out]				uint8 *a_data_Ptr:
+ *  						pointer to address that data will be stored at
+ *  [in/out]			None
+ *  [Returns]			Number of bytes read
+ *********************************************************************************/
+uint8 UART_read(uint8 *a_data_Ptr,uint8 a_length){
+	uint8 tail=g_rxTail;
+	uint8 count=(g_rxHead-tail) & UART_RX_MASK;
+	uint8 i;
+
+	if(count>a_length){
+		count=a_length;
+	}
+	for(i=0;i<count;i++){
+		/* Corrupted bytes are replaced by the safe character */
+		a_data_Ptr[i]=(g_rxStatus[tail] & ((1<<FE)|(1<<PE)))?g_config_Ptr->s_safeChar:g_rxBuffer[tail];
+		tail=(tail+1) & UART_RX_MASK;
+	}
+
+	/* Free the slots for the ISR in one store */
+	g_rxTail=tail;
+	UART_rxResume();
+	return count;
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_peek
+ *  [Description] :		This function is responsible for looking at the next
+ *  					received byte without removing it from the buffer
+ *  [Args] :
+ *  [in]				None
+ *  [out]				uint8 *a_data_Ptr:
+ *  						pointer to address that byte will be stored at
+ *  [in/out]			None
+ *  [Returns]			TRUE if a byte is available, FALSE otherwise
+ *********************************************************************************/
+bool UART_peek(uint8 *a_data_Ptr){
+	uint8 tail=g_rxTail;
+
+	if(tail==g_rxHead){
+		return FALSE;
+	}
+	*a_data_Ptr=(g_rxStatus[tail] & ((1<<FE)|(1<<PE)))?g_config_Ptr->s_safeChar:g_rxBuffer[tail];
+	return TRUE;
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_receiveBlock
+ *  [Description] :		This function is responsible for receiving a_length
+ *  					bytes as they arrived on the line, corrupted bytes are
+ *  					not replaced so the status tells them apart, 9th bits
+ *  					are not errors, UART_receiveByteStatus gives them
+ *  					Works with polling and interrupt receive modes
+ *  [Args] :
+ *  [in]				uint16 a_length:
+ *  						number of bytes to receive
+ *  [out]				uint8 *a_data_Ptr:
+ *  						pointer to address that data will be stored at
+ *  					UART_BlockStatusType *a_status_Ptr:
+ *  						error flags of the block and index of first error
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void UART_receiveBlock(uint8 *a_data_Ptr,uint16 a_length,UART_BlockStatusType *a_status_Ptr){
+	uint16 i;
+	uint8 status;
+
+	a_status_Ptr->s_errors=0;
+	a_status_Ptr->s_first_error=a_length;
+
+	for(i=0;i<a_length;i++){
+		a_data_Ptr[i]=UART_receiveByteStatus(&status);
+		status&=~UART_RX_BIT9;
+
+		if(status!=0){
+			if(a_status_Ptr->s_errors==0){
+				a_status_Ptr->s_first_error=i;
+			}
+			a_status_Ptr->s_errors|=status;
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_getErrorCounters
+ *  [Description] :		This function is responsible for copying the receive
+ *  					error counters, reception keeps running meanwhile
+ *  [Args] :
+ *  [in]				None
+ *  [out]				UART_ErrorCountersType *a_counters_Ptr:
+ *  						pointer to structure the counters are copied to
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void UART_getErrorCounters(UART_ErrorCountersType *a_counters_Ptr){
+	/* Counters are 16 bits so copy them with the ISR held off */
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		a_counters_Ptr->s_frame_errors=g_rxErrors.s_frame_errors;
+		a_counters_Ptr->s_data_overruns=g_rxErrors.s_data_overruns;
+		a_counters_Ptr->s_parity_errors=g_rxErrors.s_parity_errors;
+		a_counters_Ptr->s_buffer_overflows=g_rxErrors.s_buffer_overflows;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_sendAddress
+ *  [Description] :		This function is responsible for sending an address
+ *  					frame (9th bit set) in multi-processor mode, the data
+ *  					frames that follow are sent with UART_write as usual
+ *  [Args] :
+ *  [in]				uint8 a_address:
+ *  						address of the node that will take next data frames
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void UART_sendAddress(uint8 a_address){
+	/* Previous data frames go first */
+	UART_writeDirect(a_address,TRUE);
+}
+
+#if (UART_AUTOBAUD==1)
+/********************************************************************************
+ *  [Function Name]:	UART_autoBaud
+ *  [Description] :		This function is responsible for timing the ten edges of
+ *  					UART_AUTOBAUD_SYNC with TIMER1 input capture, choosing
+ *  					the nearest standard rate and calling UART_init with it
+ *  					-RXD (PD0) must be wired to ICP1 (PD6)
+ *  					-TIMER1 is stopped and cleared when it returns
+ *  					-Bit time must be longer than about 40 CPU cycles
+ *  [Args] :
+ *  [in]				uint16 a_timeout_ms:
+ *  						time to wait for the sync character
+ *  [out]				UART_AutoBaudType *a_result_Ptr:
+ *  						measured rate, chosen rate and its error
+ *  [in/out]			UART_ConfigType *a_config_Ptr:
+ *  						s_baudRate is replaced by the chosen rate
+ *  [Returns]			FALSE on timeout or when the edges are not a sync char
+ *********************************************************************************/
+bool UART_autoBaud(UART_ConfigType *a_config_Ptr,uint16 a_timeout_ms,UART_AutoBaudType *a_result_Ptr){
+	uint16 overflows=(uint16)(((uint32)a_timeout_ms*(F_CPU/1000UL))>>16)+1;
+	uint16 last;
+	uint16 now;
+	uint16 bit;
+	uint16 first=0;
+	uint32 total=0;
+	uint32 rate;
+	uint32 diff;
+	uint8 edge;
+	uint8 i;
+	bool valid=TRUE;
+	uint8 receiver=UCSRB & ((1<<RXEN) | (1<<RXCIE));
+
+	/* Keep receiver off so the sync character is not stored */
+	UCSRB&=~((1<<RXEN) | (1<<RXCIE));
+
+	/* TIMER1 normal mode, no prescaler, capture on falling edge (start bit) */
+	CLEAR_BIT(DDRD,PD6);
+	TCCR1A=0;
+	TCCR1B=(1<<CS10);
+	TIFR=(1<<ICF1) | (1<<TOV1);
+
+	if(!UART_waitCapture(&last,&overflows)){
+		valid=FALSE;
+	}
+
+	/* 0x55 toggles the line every bit, 9 more edges up to the stop bit */
+	for(edge=0;edge<9 && valid;edge++){
+		if(!UART_waitCapture(&now,&overflows)){
+			valid=FALSE;
+			break;
+		}
+		bit=now-last;
+		last=now;
+		if(edge==0){
+			first=bit;
+		}
+		else if(bit>first+(first>>2) || bit<first-(first>>2)){
+			/* Bits differ by more than 25% so it was not the sync char */
+			valid=FALSE;
+		}
+		total+=bit;
+	}
+
+	/* Give TIMER1 back stopped and cleared */
+	TCCR1B=0;
+	TCNT1=0;
+	TIFR=(1<<ICF1) | (1<<TOV1);
+
+	if(!valid || total==0){
+		/* Receiver and its interrupt back as they were, UART_init sets them on success */
+		UCSRB|=receiver;
+		return FALSE;
+	}
+
+	/* Nine bit times measured */
+	rate=(F_CPU*9UL+(total>>1))/total;
+	a_result_Ptr->s_measured_rate=rate;
+	a_result_Ptr->s_baudRate=rate;
+
+	for(i=0;i<sizeof(g_standardRates)/sizeof(g_standardRates[0]);i++){
+		diff=(rate>g_standardRates[i])?(rate-g_standardRates[i]):(g_standardRates[i]-rate);
+		if(diff*1000UL<=g_standardRates[i]*UART_AUTOBAUD_SNAP){
+			a_result_Ptr->s_baudRate=g_standardRates[i];
+			break;
+		}
+	}
+
+	a_config_Ptr->s_baudRate=a_result_Ptr->s_baudRate;
+	UART_init(a_config_Ptr);
+	a_result_Ptr->s_error=g_baudError;
+	return TRUE;
+}
+#endif
+
+/********************************************************************************
+ *  [Function Name]:	UART_ctsChanged
+ *  [Description] :		This function is responsible for restarting the transmit
+ *  					interrupt when CTS is asserted again, register it as
+ *  					the call back of the external interrupt on UART_CTS_PIN
+ *  					or call it when CTS is polled low
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void UART_ctsChanged(void){
+	if(BIT_IS_CLEAR(UART_CTS_IN,UART_CTS_PIN) && g_txHead!=g_txTail){
+		SET_BIT(UCSRB,UDRIE);
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	UART_txPending
+ *  [Description] :		This function is responsible for returning number of
+ *  					bytes still waiting in the transmit buffer
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Number of queued bytes
+ *********************************************************************************/
+uint8 UART_txPending(void){
+	return (g_txHead-g_txTail) & UART_TX_MASK;
+}
+
+/**********************************************************************************************
+ *  [Function Name]:	UART_callBackAdress
+ *  [Description] :		This function is responsible for saving the address that
+ *  					will be called after interrupts happen
+ *  					RX call back runs after the byte is stored in the
+ *  					receive buffer, read it with UART_read
+ *  [Args] :
+ *  [in]				void(*a_Func_Ptr)(void):
+ *  						Pointer to function used to store function's address ISR will call
+ *  					uint8 a_TorR:
+ *  						used to say the coming address for which ISR
+ *  						0 ----> RX complete
+ *  						1 ----> Data register empty
+ *  						2 ----> TX complete, TXCIE follows the address
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			The received data.
+ ***********************************************************************************************/
+void UART_callBackAdress(void(*a_Func_Ptr)(void),uint8 a_TorR){
+	if(a_TorR==1){
+		g_uartTX_Ptr=a_Func_Ptr;
+	}
+	if(a_TorR==0){
+		g_uartRX_Ptr=a_Func_Ptr;
+	}
+	if(a_TorR==2){
+		g_uartTXC_Ptr=a_Func_Ptr;
+		if(a_Func_Ptr!=NULL_PTR){
+			SET_BIT(UCSRB,TXCIE);
+		}
+		else{
+			CLEAR_BIT(UCSRB,TXCIE);
+		}
+	}
+}
+
+/**********************************************************************************************
+ *  [Function Name]:	UART_setReceiveHandler
+ *  [Description] :		This function is responsible for giving every received byte
+ *  					to an upper layer directly from USART_RXC_vect, the receive
+ *  					buffer and RX call back are bypassed while it is set
+ *  [Args] :
+ *  [in]				void(*a_handler_Ptr)(uint8,uint8):
+ *  						Handler called with the byte and its UCSRA error flags
+ *  						(FE, DOR, PE), NULL_PTR gives bytes back to the buffer
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ ***********************************************************************************************/
+void UART_setReceiveHandler(void(*a_handler_Ptr)(uint8 a_data,uint8 a_status)){
+	g_uartRxHandler_Ptr=a_handler_Ptr;
+}
@@ -18,6 +18,550 @@
 
 #include "i2c.h"
 
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* TWCR values used by the transfer state machine */
+#define I2C_TWCR_START	((1<<TWINT)|(1<<TWSTA)|(1<<TWEN)|(1<<TWIE))
+#define I2C_TWCR_NEXT	((1<<TWINT)|(1<<TWEN)|(1<<TWIE))
+#define I2C_TWCR_ACK	((1<<TWINT)|(1<<TWEN)|(1<<TWIE)|(1<<TWEA))
+#define I2C_TWCR_STOP	((1<<TWINT)|(1<<TWSTO)|(1<<TWEN))
+
+/* TWCR values of the blocking register functions, TWI_vect stays off */
+#define I2C_POLL_START	((1<<TWINT)|(1<<TWSTA)|(1<<TWEN))
+#define I2C_POLL_NEXT	((1<<TWINT)|(1<<TWEN))
+#define I2C_POLL_ACK	((1<<TWINT)|(1<<TWEN)|(1<<TWEA))
+
+/* SCL periods of one blocking step, a byte and its acknowledge */
+#define I2C_STEP_BITS 9UL
+
+/* CPU cycles of one TWINT wait loop iteration, at least this many */
+#define I2C_LOOP_CYCLES 8UL
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+/* Transfer run by TWI_vect */
+static I2C_TransactionType g_transaction;
+static volatile uint8 g_index=0;
+static volatile bool g_reading=FALSE;
+static volatile bool g_busy=FALSE;
+static uint8 g_retries=0;
+
+/* Set when a blocking wait ran out, reported by I2C_getStatus */
+static bool g_timed_out=FALSE;
+
+/* Bound of the TWINT wait loop, follows the SCL set in TWBR/TWSR */
+static uint32 g_wait_loops=0;
+
+static I2C_RecoveryStatsType g_recovery;
+
+/* Free running micro second clock of the application, times recoveries from
+ * the start of the first wait that failed since the bus last answered */
+static uint16(*g_clock_Ptr)(void)=NULL_PTR;
+static uint16 g_fail_start=0;
+static bool g_fail_pending=FALSE;
+
+/* Slave register map, g_listen keeps TWEA set so our address is answered,
+ * also in the master transmitter steps of I2C_transfer so arbitration lost
+ * to a master addressing us ends in slave mode. The blocking functions run
+ * without it and give it back with their stop */
+static const I2C_SlaveMapType *g_slave_map_Ptr=NULL_PTR;
+static uint8 g_listen=0;
+static uint8 g_slave_pointer=0;
+static bool g_slave_pointer_set=FALSE;
+static uint8 g_slave_first=0;
+static uint8 g_slave_written=0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	I2C_finish
+ *  [Description] :		This function is responsible for ending the transfer and
+ *  					reporting its result
+ *  [Args] :
+ *  [in]				uint8 a_twcr:
+ *  						last TWCR value, stop or just release the bus
+ *  					uint8 a_status:
+ *  						I2C_TRANSFER_DONE or the failing TWSR code
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void I2C_finish(uint8 a_twcr,uint8 a_status){
+	TWCR=a_twcr | g_listen;
+	g_busy=FALSE;
+	if(g_transaction.s_done_callBack_Ptr!=NULL_PTR){
+		(*g_transaction.s_done_callBack_Ptr)(a_status);
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	I2C_retry
+ *  [Description] :		This function is responsible for starting the transfer
+ *  					again from its beginning while retries are left
+ *  [Args] :
+ *  [in]				uint8 a_status:
+ *  						failing TWSR code
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			FALSE when no retry is left
+ *********************************************************************************/
+static bool I2C_retry(uint8 a_status){
+	if(g_retries==0){
+		return FALSE;
+	}
+	g_retries--;
+	g_reading=(g_transaction.s_write_length==0 && g_transaction.s_read_length>0);
+	if(a_status==TW_ARB_LOST){
+		/* Start is sent as soon as the other master frees the bus */
+		TWCR=I2C_TWCR_START | g_listen;
+	}
+	else{
+		TWCR=I2C_TWCR_START | (1<<TWSTO) | g_listen;
+	}
+	return TRUE;
+}
+
+/********************************************************************************
+ *  [Function Name]:	I2C_setWaitBound
+ *  [Description] :		This function is responsible for sizing the TWINT wait
+ *  					to one step at the SCL now set plus I2C_TIMEOUT_US of
+ *  					clock stretching, so slow rates never time out early
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void I2C_setWaitBound(void){
+	uint32 period=16UL+2UL*TWBR*I2C_PRESCALER(TWSR & 0x03);
+
+	g_wait_loops=(I2C_STEP_BITS*period+(F_CPU/1000000UL)*I2C_TIMEOUT_US)/I2C_LOOP_CYCLES+1UL;
+}
+
+/********************************************************************************
+ *  [Function Name]:	I2C_wait
+ *  [Description] :		This function is responsible for waiting for TWINT with
+ *  					a bound, g_timed_out is set when it runs out and the
+ *  					start of the first failed wait is kept for the recovery
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void I2C_wait(void){
+	uint32 loops=g_wait_loops;
+	uint16 start=0;
+
+	if(g_clock_Ptr!=NULL_PTR){
+		start=(*g_clock_Ptr)();
+	}
+	while(BIT_IS_CLEAR(TWCR,TWINT)){
+		if(--loops==0){
+			g_timed_out=TRUE;
+			if(!g_fail_pending){
+				g_fail_start=start;
+				g_fail_pending=TRUE;
+			}
+			return;
+		}
+	}
+	g_fail_pending=FALSE;
+}
+
+/********************************************************************************
+ *  [Function Name]:	I2C_step
+ *  [Description] :		This function is responsible for one blocking bus step
+ *  [Args] :
+ *  [in]				uint8 a_twcr:
+ *  						TWCR value starting the step
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			TWSR status code, I2C_TIMEOUT if TWINT did not set
+ *********************************************************************************/
+static uint8 I2C_step(uint8 a_twcr){
+	TWCR=a_twcr;
+	I2C_wait();
+	return I2C_getStatus();
+}
+
+/********************************************************************************
+ *  [Function Name]:	I2C_fail
+ *  [Description] :		This function is responsible for leaving the bus after a
+ *  					failed register transfer and naming the failure
+ *  [Args] :
+ *  [in]				uint8 a_status:
+ *  						TWSR status code or I2C_TIMEOUT
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			The result matching the status
+ *********************************************************************************/
+static I2C_Result I2C_fail(uint8 a_status){
+	I2C_Result result;
+
+	switch(a_status){
+	case I2C_TIMEOUT:
+		I2C_recoverBus();
+		return I2C_WAIT_TIMEOUT;
+	case TW_ARB_LOST:
+		/* Bus belongs to the other master, just release it */
+		TWCR=(1<<TWINT)|(1<<TWEN)|g_listen;
+		return I2C_ARBITRATION_LOST;
+	case TW_MT_SLA_W_NACK:
+	case TW_MR_SLA_R_NACK:
+		result=I2C_ADDRESS_NACK;
+		break;
+	case TW_MT_DATA_NACK:
+		result=I2C_DATA_NACK;
+		break;
+	default:
+		result=I2C_BUS_FAULT;
+		break;
+	}
+	TWCR=I2C_TWCR_STOP|g_listen;
+	return result;
+}
+
+/********************************************************************************
+ *  [Function Name]:	I2C_registers
+ *  [Description] :		This function is responsible for one register transfer:
+ *  					a single addressing phase with the register number, then
+ *  					the data written in the same frame, or a repeated start
+ *  					and a sequential read with NACK on the last byte
+ *  [Args] :
+ *  [in]				uint8 a_address:
+ *  						7-bit slave address
+ *  					const uint8 *a_register_Ptr:
+ *  						register number bytes, most significant first
+ *  					uint8 a_register_length:
+ *  						1 or 2
+ *  					const uint8 *a_tx_Ptr:
+ *  						bytes to write, NULL_PTR to read instead
+ *  					uint8 a_length:
+ *  						number of data bytes
+ *  [out]				uint8 *a_rx_Ptr:
+ *  						read bytes when a_tx_Ptr is NULL_PTR
+ *  [in/out]			None
+ *  [Returns]			I2C_OK or the reason of failure
+ *********************************************************************************/
+static I2C_Result I2C_registers(uint8 a_address,const uint8 *a_register_Ptr,uint8 a_register_length,
+		const uint8 *a_tx_Ptr,uint8 *a_rx_Ptr,uint8 a_length){
+	uint8 status;
+	uint8 i;
+
+	if(g_busy){
+		return I2C_BUSY;
+	}
+	g_timed_out=FALSE;
+
+	status=I2C_step(I2C_POLL_START);
+	if(status!=TW_START){
+		return I2C_fail(status);
+	}
+	TWDR=(uint8)(a_address<<1);
+	status=I2C_step(I2C_POLL_NEXT);
+	if(status!=TW_MT_SLA_W_ACK){
+		return I2C_fail(status);
+	}
+
+	/* Register number then data share one write frame */
+	for(i=0;i<a_register_length;i++){
+		TWDR=a_register_Ptr[i];
+		status=I2C_step(I2C_POLL_NEXT);
+		if(status!=TW_MT_DATA_ACK){
+			return I2C_fail(status);
+		}
+	}
+	if(a_tx_Ptr!=NULL_PTR){
+		for(i=0;i<a_length;i++){
+			TWDR=a_tx_Ptr[i];
+			status=I2C_step(I2C_POLL_NEXT);
+			if(status!=TW_MT_DATA_ACK){
+				return I2C_fail(status);
+			}
+		}
+	}
+	else if(a_length>0){
+		status=I2C_step(I2C_POLL_START);
+		if(status!=TW_REP_START){
+			return I2C_fail(status);
+		}
+		TWDR=(uint8)((a_address<<1) | 1);
+		status=I2C_step(I2C_POLL_NEXT);
+		if(status!=TW_MT_SLA_R_ACK){
+			return I2C_fail(status);
+		}
+
+		/* Stop at the first byte that is not ACKed data, a lost arbitration must
+		 * leave the bus to the other master without any recovery clocks */
+		for(i=0;i<(uint8)(a_length-1);i++){
+			TWCR=I2C_POLL_ACK;
+			I2C_wait();
+			if((TWSR & 0xF8)!=TW_MR_DATA_ACK){
+				return I2C_fail(I2C_getStatus());
+			}
+			a_rx_Ptr[i]=TWDR;
+		}
+		status=I2C_step(I2C_POLL_NEXT);
+		a_rx_Ptr[a_length-1]=TWDR;
+		if(status!=TW_MR_DATA_NACK){
+			return I2C_fail(status);
+		}
+	}
+
+	TWCR=I2C_TWCR_STOP|g_listen;
+	return I2C_OK;
+}
+
+/********************************************************************************
+ *  [Function Name]:	I2C_ackNext
+ *  [Description] :		This function is responsible for asking the next byte,
+ *  					ACK while more than one byte is left and NACK for the last
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void I2C_ackNext(void){
+	if((uint8)(g_transaction.s_read_length-g_index)>1){
+		TWCR=I2C_TWCR_ACK;
+	}
+	else{
+		TWCR=I2C_TWCR_NEXT;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	I2C_slaveLostArbitration
+ *  [Description] :		This function is responsible for ending a master transfer
+ *  					that lost arbitration because another master addressed us
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void I2C_slaveLostArbitration(void){
+	if(g_busy){
+		g_busy=FALSE;
+		if(g_transaction.s_done_callBack_Ptr!=NULL_PTR){
+			(*g_transaction.s_done_callBack_Ptr)(TW_ARB_LOST);
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	I2C_slaveReceive
+ *  [Description] :		This function is responsible for taking a byte written by
+ *  					the master, first one is the register pointer
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						received byte
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			FALSE when the pointer is past the map so the next
+ *  					byte has to be NACKed
+ *********************************************************************************/
+static bool I2C_slaveReceive(uint8 a_data){
+	const I2C_SlaveMapType *map_Ptr=g_slave_map_Ptr;
+	uint8 mask;
+
+	if(!g_slave_pointer_set){
+		g_slave_pointer=a_data;
+		g_slave_pointer_set=TRUE;
+		g_slave_first=a_data;
+		g_slave_written=0;
+	}
+	else if(g_slave_pointer<map_Ptr->s_count){
+		mask=(map_Ptr->s_read_only_Ptr!=NULL_PTR) ? map_Ptr->s_read_only_Ptr[g_slave_pointer] : 0;
+		map_Ptr->s_registers_Ptr[g_slave_pointer]=(map_Ptr->s_registers_Ptr[g_slave_pointer] & mask) | (a_data & (~mask));
+		g_slave_written++;
+		g_slave_pointer++;
+	}
+	/* The pointer never wraps into the first registers */
+	return (g_slave_pointer<map_Ptr->s_count);
+}
+
+/********************************************************************************
+ *  [Function Name]:	I2C_slaveWriteDone
+ *  [Description] :		This function is responsible for reporting the registers
+ *  					the master wrote once the write ended
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void I2C_slaveWriteDone(void){
+	if(g_slave_written>0 && g_slave_map_Ptr->s_write_callBack_Ptr!=NULL_PTR){
+		(*g_slave_map_Ptr->s_write_callBack_Ptr)(g_slave_first,g_slave_written);
+	}
+	g_slave_written=0;
+}
+
+/********************************************************************************
+ *  [Function Name]:	I2C_slaveTransmit
+ *  [Description] :		This function is responsible for loading the register the
+ *  					master reads next and moving the pointer, past the map
+ *  					0xFF is sent and the pointer stays there
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void I2C_slaveTransmit(void){
+	const I2C_SlaveMapType *map_Ptr=g_slave_map_Ptr;
+
+	if(g_slave_pointer<map_Ptr->s_count){
+		TWDR=map_Ptr->s_registers_Ptr[g_slave_pointer];
+		g_slave_pointer++;
+	}
+	else{
+		TWDR=0xFF;
+	}
+}
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+/* Moves the transfer one step per bus event */
+ISR(TWI_vect){
+	uint8 status=TWSR & 0xF8;
+
+	switch(status){
+	case TW_START:
+	case TW_REP_START:
+		g_index=0;
+		TWDR=(g_transaction.s_address<<1) | (g_reading ? 1 : 0);
+		TWCR=I2C_TWCR_NEXT | g_listen;
+		break;
+
+	case TW_MT_SLA_W_ACK:
+	case TW_MT_DATA_ACK:
+		if(g_index<g_transaction.s_write_length){
+			TWDR=g_transaction.s_write_Ptr[g_index];
+			g_index++;
+			TWCR=I2C_TWCR_NEXT | g_listen;
+		}
+		else if(g_transaction.s_read_length>0){
+			g_reading=TRUE;
+			if(g_transaction.s_repeated_start){
+				TWCR=I2C_TWCR_START | g_listen;
+			}
+			else{
+				/* Stop followed by a new start */
+				TWCR=I2C_TWCR_START | (1<<TWSTO) | g_listen;
+			}
+		}
+		else{
+			I2C_finish(I2C_TWCR_STOP,I2C_TRANSFER_DONE);
+		}
+		break;
+
+	case TW_MT_SLA_R_ACK:
+		I2C_ackNext();
+		break;
+
+	case TW_MR_DATA_ACK:
+		g_transaction.s_read_Ptr[g_index]=TWDR;
+		g_index++;
+		I2C_ackNext();
+		break;
+
+	case TW_MR_DATA_NACK:
+		g_transaction.s_read_Ptr[g_index]=TWDR;
+		I2C_finish(I2C_TWCR_STOP,I2C_TRANSFER_DONE);
+		break;
+
+	case TW_ARB_LOST:
+		if(!I2C_retry(status)){
+			/* Bus belongs to the other master, just release it */
+			I2C_finish((1<<TWINT)|(1<<TWEN),status);
+		}
+		break;
+
+	case TW_MT_SLA_W_NACK:
+	case TW_MT_DATA_NACK:
+	case TW_MR_SLA_R_NACK:
+		if(!I2C_retry(status)){
+			I2C_finish(I2C_TWCR_STOP,status);
+		}
+		break;
+
+	/* Slave receiver, general call writes go to the map too */
+	case TW_SR_ARB_LOST_SLA:
+	case TW_SR_ARB_LOST_GCALL:
+		I2C_slaveLostArbitration();
+		/* fall through */
+	case TW_SR_SLA_ACK:
+	case TW_SR_GCALL_ACK:
+		g_slave_pointer_set=FALSE;
+		g_slave_written=0;
+		TWCR=I2C_TWCR_ACK;
+		break;
+
+	case TW_SR_DATA_ACK:
+	case TW_SR_GCALL_DATA_ACK:
+		if(I2C_slaveReceive(TWDR)){
+			TWCR=I2C_TWCR_ACK;
+		}
+		else{
+			/* Out of the map, NACK the rest of the write */
+			TWCR=I2C_TWCR_NEXT;
+		}
+		break;
+
+	case TW_SR_STOP:
+		I2C_slaveWriteDone();
+		TWCR=I2C_TWCR_ACK;
+		break;
+
+	/* Slave transmitter, register pointer kept from the last write */
+	case TW_ST_ARB_LOST_SLA:
+		I2C_slaveLostArbitration();
+		/* fall through */
+	case TW_ST_SLA_ACK:
+	case TW_ST_DATA_ACK:
+		I2C_slaveTransmit();
+		TWCR=I2C_TWCR_ACK;
+		break;
+
+	case TW_SR_DATA_NACK:
+	case TW_SR_GCALL_DATA_NACK:
+		/* Byte past the map was NACKed, no longer addressed so the STOP
+		 * will not come, report what was written before it now */
+		I2C_slaveWriteDone();
+		TWCR=I2C_TWCR_ACK;
+		break;
+
+	case TW_ST_DATA_NACK:
+	case TW_ST_LAST_DATA:
+		/* Back to listening for our address */
+		TWCR=I2C_TWCR_ACK;
+		break;
+
+	default:
+		/* Bus error, stop also recovers from it */
+		if(g_busy){
+			I2C_finish(I2C_TWCR_STOP,status);
+		}
+		else{
+			/* Only the slave was running, there is no transfer to report */
+			TWCR=I2C_TWCR_STOP | g_listen;
+		}
+		break;
+	}
+}
+
 /*******************************************************************************
  *                      Functions Definitions                                  *
  *******************************************************************************/
@@ -42,18 +586,23 @@ void I2C_init(const I2C_ConfigType *a_config_Ptr){
 	 * Setting Prescaler bitsi TWBR
 	 */
 	case LOW_MODE_10KB:
-		TWBR=98;
-		TWSR=1;
+		TWBR=I2C_TWBR_FOR(10000UL);
+		TWSR=I2C_TWPS_FOR(10000UL);
 		break;
 	case STANDARD_MODE_100KB:
-		TWBR=8;
-		TWSR=1;
+		TWBR=I2C_TWBR_FOR(100000UL);
+		TWSR=I2C_TWPS_FOR(100000UL);
 		break;
 	case FAST_MODE_400KB:
-		TWBR=2;
-		TWSR=0;
+		TWBR=I2C_TWBR_FOR(400000UL);
+		TWSR=I2C_TWPS_FOR(400000UL);
+		break;
+	case CUSTOM_MODE:
+		TWBR=I2C_TWBR_VALUE;
+		TWSR=I2C_TWPS_VALUE;
 		break;
 	}
+	I2C_setWaitBound();
 
 	/*
 	 * My address as slave
@@ -78,15 +627,25 @@ void I2C_start(void){
 	 * Enable TWEN again.
 	 * Sending start bit.
 	 */
+	g_timed_out=FALSE;
 	TWCR=(1<<TWSTA)|(1<<TWEN)|(1<<TWINT);
 
 	/* Wait until start bit is sent */
-	while(BIT_IS_CLEAR(TWCR,TWINT));
+	I2C_wait();
+
+	/* Bus stuck, free it and try once more */
+	if(g_timed_out){
+		I2C_recoverBus();
+		g_timed_out=FALSE;
+		TWCR=(1<<TWSTA)|(1<<TWEN)|(1<<TWINT);
+		I2C_wait();
+	}
 }
 
 /*************************************************************************************
  *  [Function Name]:	I2C_stop
- *  [Description] :		This function is responsible for sending stop bit
+ *  [Description] :		This function is responsible for sending stop bit, the
+ *  					slave paused by the blocking functions listens again
  *  [Args] :
  *  [in]				None
  *  [out]				None
@@ -99,7 +658,7 @@ void I2C_stop(void){
 	 * Enable TWEN again.
 	 * Sending stop bit.
 	 */
-	TWCR=(1<<TWSTO)|(1<<TWEN)|(1<<TWINT);
+	TWCR=(1<<TWSTO)|(1<<TWEN)|(1<<TWINT)|g_listen;
 }
 
 /******************************************************************************************
@@ -124,7 +683,7 @@ void I2C_write(uint8 data){
 	TWCR=(1<<TWEN)|(1<<TWINT);
 
 	/* Wait until data is sent */
-	while(BIT_IS_CLEAR(TWCR,TWINT));
+	I2C_wait();
 }
 
 /*************************************************************************************
@@ -146,7 +705,7 @@ uint8 I2C_readWithACK(void){
 	TWCR=(1<<TWEN)|(1<<TWINT)|(1<<TWEA);
 
 	/* Wait until data is received */
-	while(BIT_IS_CLEAR(TWCR,TWINT));
+	I2C_wait();
 
 	/* Return received data*/
 	return TWDR;
@@ -169,7 +728,7 @@ uint8 I2C_readWithNACK(void){
 	TWCR=(1<<TWEN)|(1<<TWINT);
 
 	/* Wait until data is received */
-	while(BIT_IS_CLEAR(TWCR,TWINT));
+	I2C_wait();
 
 	/* Return received data*/
 	return TWDR;
@@ -183,9 +742,335 @@ uint8 I2C_readWithNACK(void){
  *  [in]				None
  *  [out]				None
  *  [in/out]			None
- *  [Returns]			None
+ *  [Returns]			TWSR status code, I2C_TIMEOUT if the last wait ran out
  **************************************************************************************/
 uint8 I2C_getStatus(void){
+	if(g_timed_out){
+		return I2C_TIMEOUT;
+	}
 	/* Return the code of finished current action */
 	return (TWSR&0xF8);
 }
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_transfer
+ *  [Description] :		This function is responsible for starting a transfer that
+ *  					TWI_vect runs from start to stop, the CPU is free until
+ *  					the call back. Nothing bounds it: if a slave holds SCL
+ *  					low the transfer stays busy, so the application bounds
+ *  					its wait and calls I2C_recoverBus, which ends the
+ *  					transfer with I2C_TIMEOUT
+ *  [Args] :
+ *  [in]				const I2C_TransactionType *a_transaction_Ptr:
+ *  						transfer, copied, its buffers must stay valid until
+ *  						the call back, no lengths means an address probe
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			FALSE when a transfer is already running
+ **************************************************************************************/
+bool I2C_transfer(const I2C_TransactionType *a_transaction_Ptr){
+	if(g_busy){
+		return FALSE;
+	}
+	g_transaction=*a_transaction_Ptr;
+	g_index=0;
+	/* Skip the write phase when there is only something to read */
+	g_reading=(a_transaction_Ptr->s_write_length==0 && a_transaction_Ptr->s_read_length>0);
+	g_retries=I2C_RETRIES;
+	g_busy=TRUE;
+
+	TWCR=I2C_TWCR_START | g_listen;
+	return TRUE;
+}
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_isBusy
+ *  [Description] :		This function is responsible for telling if I2C_transfer
+ *  					is still running
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			TRUE until the call back of the transfer was called
+ **************************************************************************************/
+bool I2C_isBusy(void){
+	return g_busy;
+}
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_initSlave
+ *  [Description] :		This function is responsible for answering our address
+ *  					(set by I2C_init) from TWI_vect with a register map,
+ *  					every status is handled inside the interrupt so SCL is
+ *  					stretched only for the ISR time, the blocking functions
+ *  					pause it from their start until their stop
+ *  [Args] :
+ *  [in]				const I2C_SlaveMapType *a_map_Ptr:
+ *  						register map, must stay valid while the slave runs
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ **************************************************************************************/
+void I2C_initSlave(const I2C_SlaveMapType *a_map_Ptr){
+	g_slave_map_Ptr=a_map_Ptr;
+	g_slave_pointer=0;
+	g_slave_pointer_set=FALSE;
+	g_slave_written=0;
+	g_listen=(1<<TWEA)|(1<<TWIE);
+
+	if(!g_busy){
+		TWCR=(1<<TWEN)|g_listen;
+	}
+}
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_writeRegs
+ *  [Description] :		This function is responsible for writing consecutive
+ *  					registers of a slave with 8-bit register numbers
+ *  [Args] :
+ *  [in]				uint8 a_address:
+ *  						7-bit slave address
+ *  					uint8 a_register:
+ *  						first register
+ *  					const uint8 *a_data_Ptr:
+ *  						bytes to write
+ *  					uint8 a_length:
+ *  						number of bytes
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			I2C_OK or the reason of failure
+ **************************************************************************************/
+I2C_Result I2C_writeRegs(uint8 a_address,uint8 a_register,const uint8 *a_data_Ptr,uint8 a_length){
+	return I2C_registers(a_address,&a_register,1,a_data_Ptr,NULL_PTR,a_length);
+}
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_readRegs
+ *  [Description] :		This function is responsible for reading consecutive
+ *  					registers of a slave with 8-bit register numbers
+ *  [Args] :
+ *  [in]				uint8 a_address:
+ *  						7-bit slave address
+ *  					uint8 a_register:
+ *  						first register
+ *  					uint8 a_length:
+ *  						number of bytes
+ *  [out]				uint8 *a_data_Ptr:
+ *  						pointer to address that data will be stored at
+ *  [in/out]			None
+ *  [Returns]			I2C_OK or the reason of failure
+ **************************************************************************************/
+I2C_Result I2C_readRegs(uint8 a_address,uint8 a_register,uint8 *a_data_Ptr,uint8 a_length){
+	return I2C_registers(a_address,&a_register,1,NULL_PTR,a_data_Ptr,a_length);
+}
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_writeRegs16
+ *  [Description] :		This function is responsible for writing consecutive
+ *  					registers of a slave with 16-bit register numbers
+ *  					(e.g. bigger EEPROMs), sent most significant byte first
+ *  [Args] :
+ *  [in]				uint8 a_address:
+ *  						7-bit slave address
+ *  					uint16 a_register:
+ *  						first register
+ *  					const uint8 *a_data_Ptr:
+ *  						bytes to write
+ *  					uint8 a_length:
+ *  						number of bytes
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			I2C_OK or the reason of failure
+ **************************************************************************************/
+I2C_Result I2C_writeRegs16(uint8 a_address,uint16 a_register,const uint8 *a_data_Ptr,uint8 a_length){
+	uint8 reg[2];
+
+	reg[0]=(uint8)(a_register>>8);
+	reg[1]=(uint8)(a_register);
+	return I2C_registers(a_address,reg,2,a_data_Ptr,NULL_PTR,a_length);
+}
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_readRegs16
+ *  [Description] :		This function is responsible for reading consecutive
+ *  					registers of a slave with 16-bit register numbers,
+ *  					sent most significant byte first
+ *  [Args] :
+ *  [in]				uint8 a_address:
+ *  						7-bit slave address
+ *  					uint16 a_register:
+ *  						first register
+ *  					uint8 a_length:
+ *  						number of bytes
+ *  [out]				uint8 *a_data_Ptr:
+ *  						pointer to address that data will be stored at
+ *  [in/out]			None
+ *  [Returns]			I2C_OK or the reason of failure
+ **************************************************************************************/
+I2C_Result I2C_readRegs16(uint8 a_address,uint16 a_register,uint8 *a_data_Ptr,uint8 a_length){
+	uint8 reg[2];
+
+	reg[0]=(uint8)(a_register>>8);
+	reg[1]=(uint8)(a_register);
+	return I2C_registers(a_address,reg,2,NULL_PTR,a_data_Ptr,a_length);
+}
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_setFrequency
+ *  [Description] :		This function is responsible for setting any SCL frequency
+ *  					at run time with the same rules as the compile time values
+ *  [Args] :
+ *  [in]				uint32 a_frequency:
+ *  						target SCL frequency in Hz
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Real SCL frequency, 0 if the target can not be reached and
+ *  					nothing was changed
+ **************************************************************************************/
+uint32 I2C_setFrequency(uint32 a_frequency){
+	uint32 divider;
+	uint32 twbr;
+	uint8 twps;
+
+	if(a_frequency==0 || a_frequency>400000UL){
+		return 0;
+	}
+	divider=(F_CPU+a_frequency-1UL)/a_frequency;
+	/* Same rule as I2C_TOO_FAST, TWBR_MIN itself is legal */
+	if(divider<16UL+2UL*I2C_TWBR_MIN){
+		return 0;
+	}
+
+	for(twps=0;twps<4;twps++){
+		twbr=(divider-16UL+2UL*I2C_PRESCALER(twps)-1UL)/(2UL*I2C_PRESCALER(twps));
+		if(twbr<=255UL){
+			TWBR=(uint8)twbr;
+			TWSR=twps;
+			I2C_setWaitBound();
+			return I2C_SCL_REAL(twbr,twps);
+		}
+	}
+	return 0;
+}
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_getFrequency
+ *  [Description] :		This function is responsible for reporting the SCL
+ *  					frequency TWBR and TWSR give now
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			SCL frequency in Hz
+ **************************************************************************************/
+uint32 I2C_getFrequency(void){
+	return I2C_SCL_REAL((uint32)TWBR,(uint32)(TWSR & 0x03));
+}
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_recoverBus
+ *  [Description] :		This function is responsible for freeing a bus whose SDA
+ *  					is held low by a slave stopped in the middle of a byte,
+ *  					SCL is clocked by hand up to nine times then STOP is
+ *  					sent, a running I2C_transfer ends with I2C_TIMEOUT. With
+ *  					a clock set the time from the start of the failed wait,
+ *  					or from here if none failed, to the end of the STOP is
+ *  					recorded
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			TRUE if both lines are high afterwards
+ **************************************************************************************/
+bool I2C_recoverBus(void){
+	uint8 clocks=0;
+	uint16 start=0;
+	uint16 time;
+	bool result;
+
+	if(g_clock_Ptr!=NULL_PTR){
+		start=g_fail_pending ? g_fail_start : (*g_clock_Ptr)();
+	}
+	g_fail_pending=FALSE;
+
+	/* TWI off gives the pins back, lines are driven open drain with DDR */
+	TWCR=0;
+	CLEAR_BIT(I2C_PORT,I2C_SCL);
+	CLEAR_BIT(I2C_PORT,I2C_SDA);
+	CLEAR_BIT(I2C_DDR,I2C_SCL);
+	CLEAR_BIT(I2C_DDR,I2C_SDA);
+
+	while(BIT_IS_CLEAR(I2C_PIN,I2C_SDA) && clocks<9){
+		SET_BIT(I2C_DDR,I2C_SCL);
+		_delay_us(I2C_RECOVERY_HALF_US);
+		CLEAR_BIT(I2C_DDR,I2C_SCL);
+		_delay_us(I2C_RECOVERY_HALF_US);
+		clocks++;
+	}
+
+	/* STOP, SDA rises while SCL is high */
+	SET_BIT(I2C_DDR,I2C_SCL);
+	SET_BIT(I2C_DDR,I2C_SDA);
+	_delay_us(I2C_RECOVERY_HALF_US);
+	CLEAR_BIT(I2C_DDR,I2C_SCL);
+	_delay_us(I2C_RECOVERY_HALF_US);
+	CLEAR_BIT(I2C_DDR,I2C_SDA);
+	_delay_us(I2C_RECOVERY_HALF_US);
+
+	result=BIT_IS_SET(I2C_PIN,I2C_SDA) && BIT_IS_SET(I2C_PIN,I2C_SCL);
+
+	g_recovery.s_recoveries++;
+	if(!result){
+		g_recovery.s_failures++;
+	}
+	if(g_clock_Ptr!=NULL_PTR){
+		time=(*g_clock_Ptr)()-start;
+		g_recovery.s_last_time_us=time;
+		if(time>g_recovery.s_max_time_us){
+			g_recovery.s_max_time_us=time;
+		}
+	}
+
+	TWCR=(1<<TWEN) | g_listen;
+
+	if(g_busy){
+		g_busy=FALSE;
+		if(g_transaction.s_done_callBack_Ptr!=NULL_PTR){
+			(*g_transaction.s_done_callBack_Ptr)(I2C_TIMEOUT);
+		}
+	}
+	return result;
+}
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_getRecoveryStats
+ *  [Description] :		This function is responsible for copying the bus recovery
+ *  					record, s_max_time_us is the worst case latency added
+ *  [Args] :
+ *  [in]				None
+ *  [out]				I2C_RecoveryStatsType *a_stats_Ptr:
+ *  						pointer to structure the record is copied to
+ *  [in/out]			None
+ *  [Returns]			None
+ **************************************************************************************/
+void I2C_getRecoveryStats(I2C_RecoveryStatsType *a_stats_Ptr){
+	*a_stats_Ptr=g_recovery;
+}
+
+/*************************************************************************************
+ *  [Function Name]:	I2C_setClock
+ *  [Description] :		This function is responsible for setting the free running
+ *  					clock that times bus recoveries, for example TCNT1 with
+ *  					TIMER1 in normal mode at F_CPU/1 when F_CPU is 1MHz
+ *  [Args] :
+ *  [in]				uint16(*a_clock_Ptr)(void):
+ *  						returns micro seconds wrapping at 16 bits, NULL_PTR
+ *  						stops the timing
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ **************************************************************************************/
+void I2C_setClock(uint16(*a_clock_Ptr)(void)){
+	g_clock_Ptr=a_clock_Ptr;
+	g_fail_pending=FALSE;
+}
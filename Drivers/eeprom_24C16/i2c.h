@@ -26,9 +26,11 @@
  *                         Types Declaration                                   *
  *******************************************************************************/
 
+/* Fixed speeds are clamped to what F_CPU can give,
+ * CUSTOM_MODE uses I2C_SCL_FREQUENCY checked at compile time */
 typedef enum
 {
-	LOW_MODE_10KB,STANDARD_MODE_100KB,FAST_MODE_400KB
+	LOW_MODE_10KB,STANDARD_MODE_100KB,FAST_MODE_400KB,CUSTOM_MODE
 }I2C_Speed;
 
 
@@ -40,6 +42,47 @@ typedef struct
 
 }I2C_ConfigType;
 
+/* One master transfer run by TWI_vect, write phase then read phase */
+typedef struct
+{
+	uint8		s_address;			/* 7-bit slave address */
+	const uint8	*s_write_Ptr;
+	uint8		s_write_length;
+	uint8		*s_read_Ptr;
+	uint8		s_read_length;
+	bool		s_repeated_start;	/* Read after a repeated start, else after stop and start */
+	void(*s_done_callBack_Ptr)(uint8 a_status);	/* I2C_TRANSFER_DONE or failing TWSR code */
+}I2C_TransactionType;
+
+/* Register map served as slave, first byte written after our address sets
+ * the register pointer, it moves by one after every byte read or written.
+ * It stops at the end of the map: further writes are NACKed and further
+ * reads give 0xFF */
+typedef struct
+{
+	uint8		*s_registers_Ptr;
+	const uint8	*s_read_only_Ptr;	/* Per register, bits set can not be written, NULL_PTR all writable */
+	uint8		s_count;
+	void(*s_write_callBack_Ptr)(uint8 a_first,uint8 a_count);	/* After stop of a write, from TWI_vect */
+}I2C_SlaveMapType;
+
+/* Bus recovery record, times are measured with the I2C_setClock clock from
+ * the start of the first failed wait to the end of the STOP, so they hold the
+ * wait timeouts too. They stay 0 without a clock */
+typedef struct
+{
+	uint16 s_recoveries;
+	uint16 s_failures;			/* SDA or SCL still low after recovery */
+	uint16 s_last_time_us;
+	uint16 s_max_time_us;
+}I2C_RecoveryStatsType;
+
+/* Result of the register functions, hides the TWSR codes from device drivers */
+typedef enum
+{
+	I2C_OK,I2C_ADDRESS_NACK,I2C_DATA_NACK,I2C_ARBITRATION_LOST,I2C_BUS_FAULT,I2C_WAIT_TIMEOUT,I2C_BUSY
+}I2C_Result;
+
 /*******************************************************************************
  *                      Preprocessor Macros                                    *
  *******************************************************************************/
@@ -51,6 +94,98 @@ typedef struct
 #define TW_MT_DATA_ACK   0x28 /* Master transmit data and ACK has been received from Slave.*/
 #define TW_MR_DATA_ACK   0x50 /* Master received data and send ACK to slave */
 #define TW_MR_DATA_NACK  0x58 /* Master received data but doesn't send ACK to slave*/
+#define TW_MT_SLA_W_NACK 0x20 /* Slave address + Write request not acknowledged */
+#define TW_MT_DATA_NACK  0x30 /* Master transmit data and NACK has been received from Slave */
+#define TW_ARB_LOST      0x38 /* Arbitration lost to another master */
+#define TW_MR_SLA_R_NACK 0x48 /* Slave address + Read request not acknowledged */
+#define TW_BUS_ERROR     0x00 /* Illegal start or stop on the bus */
+
+/* Slave receiver status codes */
+#define TW_SR_SLA_ACK        0x60 /* Own slave address + Write received, ACK returned */
+#define TW_SR_ARB_LOST_SLA   0x68 /* Arbitration lost as master, own address + Write received */
+#define TW_SR_GCALL_ACK      0x70 /* General call received, ACK returned */
+#define TW_SR_ARB_LOST_GCALL 0x78 /* Arbitration lost as master, general call received */
+#define TW_SR_DATA_ACK       0x80 /* Data received after own address, ACK returned */
+#define TW_SR_DATA_NACK      0x88 /* Data received after own address, NACK returned */
+#define TW_SR_GCALL_DATA_ACK 0x90 /* Data received after general call, ACK returned */
+#define TW_SR_GCALL_DATA_NACK 0x98 /* Data received after general call, NACK returned */
+#define TW_SR_STOP           0xA0 /* Stop or repeated start received while addressed */
+
+/* Slave transmitter status codes */
+#define TW_ST_SLA_ACK        0xA8 /* Own slave address + Read received, ACK returned */
+#define TW_ST_ARB_LOST_SLA   0xB0 /* Arbitration lost as master, own address + Read received */
+#define TW_ST_DATA_ACK       0xB8 /* Data transmitted, ACK received */
+#define TW_ST_DATA_NACK      0xC0 /* Data transmitted, NACK received */
+#define TW_ST_LAST_DATA      0xC8 /* Last data transmitted with TWEA cleared, ACK received */
+
+/* Status given to the transfer call back on success, not a TWSR code */
+#define I2C_TRANSFER_DONE 0xFF
+
+/* Target SCL frequency of CUSTOM_MODE, left undefined the fastest legal
+ * rate is used: 400KHz or the TWBR lower limit of this F_CPU */
+/* #define I2C_SCL_FREQUENCY 100000UL */
+
+/* Datasheet lowest TWBR in master mode */
+#define I2C_TWBR_MIN 10UL
+
+/* SCL = F_CPU/(16+2*TWBR*4^TWPS) */
+#define I2C_PRESCALER(TWPS)		(1UL<<(2UL*(TWPS)))
+#define I2C_SCL_REAL(TWBR,TWPS)	((F_CPU)/(16UL+2UL*(TWBR)*I2C_PRESCALER(TWPS)))
+
+/* Smallest F_CPU/SCL divider not above the target, then TWBR rounded up
+ * so the bus never runs faster than asked */
+#define I2C_DIVIDER(SCL)		(((F_CPU)+(SCL)-1UL)/(SCL))
+#define I2C_TWBR_CALC(SCL,TWPS)	((I2C_DIVIDER(SCL)-16UL+2UL*I2C_PRESCALER(TWPS)-1UL)/(2UL*I2C_PRESCALER(TWPS)))
+
+/* Too fast for the clock when even TWBR_MIN without prescaler is slower */
+#define I2C_TOO_FAST(SCL)		(I2C_DIVIDER(SCL)<16UL+2UL*I2C_TWBR_MIN)
+
+/* Smallest prescaler whose TWBR fits, clamped to the reachable range */
+#define I2C_TWPS_FOR(SCL)	\
+	(I2C_TOO_FAST(SCL)?0UL:I2C_TWBR_CALC(SCL,0UL)<=255UL?0UL:I2C_TWBR_CALC(SCL,1UL)<=255UL?1UL: \
+	I2C_TWBR_CALC(SCL,2UL)<=255UL?2UL:3UL)
+#define I2C_TWBR_FOR(SCL)	\
+	(I2C_TOO_FAST(SCL)?I2C_TWBR_MIN:I2C_TWBR_CALC(SCL,I2C_TWPS_FOR(SCL))<=255UL? \
+	I2C_TWBR_CALC(SCL,I2C_TWPS_FOR(SCL)):255UL)
+
+/* Values calculated at compile time for CUSTOM_MODE */
+#ifdef I2C_SCL_FREQUENCY
+#define I2C_TWBR_VALUE	I2C_TWBR_FOR(I2C_SCL_FREQUENCY)
+#define I2C_TWPS_VALUE	I2C_TWPS_FOR(I2C_SCL_FREQUENCY)
+#if (I2C_SCL_FREQUENCY) > 400000UL
+#error "I2C_SCL_FREQUENCY is above the 400KHz fast mode limit"
+#elif I2C_TOO_FAST(I2C_SCL_FREQUENCY)
+#error "I2C_SCL_FREQUENCY needs TWBR below 10 at this F_CPU"
+#elif I2C_TWBR_CALC(I2C_SCL_FREQUENCY,3UL)>255UL
+#error "I2C_SCL_FREQUENCY is below the slowest rate of this F_CPU"
+#endif
+#else
+#define I2C_TWBR_VALUE	I2C_TWBR_FOR(400000UL)
+#define I2C_TWPS_VALUE	I2C_TWPS_FOR(400000UL)
+#endif
+
+/* SCL frequency CUSTOM_MODE really gives */
+#define I2C_SCL_VALUE	I2C_SCL_REAL(I2C_TWBR_VALUE,I2C_TWPS_VALUE)
+
+/* Status when TWINT did not set in time or the bus was recovered, not a TWSR code */
+#define I2C_TIMEOUT 0x01
+
+/* Clock stretching allowed to one bus step of the blocking functions, the
+ * wait is this plus nine SCL periods at the rate in use */
+#define I2C_TIMEOUT_US 2000UL
+
+/* Times a master transfer is started again after arbitration loss or NACK */
+#define I2C_RETRIES 3
+
+/* Bus pins, driven by hand during recovery */
+#define I2C_PORT	PORTC
+#define I2C_DDR		DDRC
+#define I2C_PIN		PINC
+#define I2C_SCL		PC0
+#define I2C_SDA		PC1
+
+/* Half SCL period of the recovery clocks, 5us gives 100KHz */
+#define I2C_RECOVERY_HALF_US 5
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
@@ -62,4 +197,16 @@ void I2C_write(uint8 data);
 uint8 I2C_readWithACK(void); //read with send Ack
 uint8 I2C_readWithNACK(void); //read without send Ack
 uint8 I2C_getStatus(void);
+bool I2C_transfer(const I2C_TransactionType *a_transaction_Ptr); //interrupt driven transfer, not time bounded
+bool I2C_isBusy(void);
+void I2C_initSlave(const I2C_SlaveMapType *a_map_Ptr); //serve a register map as slave
+I2C_Result I2C_writeRegs(uint8 a_address,uint8 a_register,const uint8 *a_data_Ptr,uint8 a_length);
+I2C_Result I2C_readRegs(uint8 a_address,uint8 a_register,uint8 *a_data_Ptr,uint8 a_length);
+I2C_Result I2C_writeRegs16(uint8 a_address,uint16 a_register,const uint8 *a_data_Ptr,uint8 a_length);
+I2C_Result I2C_readRegs16(uint8 a_address,uint16 a_register,uint8 *a_data_Ptr,uint8 a_length);
+uint32 I2C_setFrequency(uint32 a_frequency); //any SCL at run time, returns the real one
+uint32 I2C_getFrequency(void); //SCL set in TWBR/TWSR
+bool I2C_recoverBus(void); //free SDA held low by a slave
+void I2C_getRecoveryStats(I2C_RecoveryStatsType *a_stats_Ptr);
+void I2C_setClock(uint16(*a_clock_Ptr)(void)); //free running micro second clock timing recoveries
 #endif /* I2C_H_ */
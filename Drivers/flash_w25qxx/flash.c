@@ -0,0 +1,548 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<flash.c>
+ *
+ * [MODULE]:		<FLASH>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Source file for the W25Qxx SPI NOR flash driver>
+ * 					<Writes are collected in a one page RAM cache, a page that
+ * 					 needs bits set back to 1 is written by copying its sector
+ * 					 to a scratch sector at the end of the chip, erasing and
+ * 					 copying back. The scratch sectors are used in turn>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "flash.h"
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+/* Device index of the flash in the SPI table */
+static uint8 g_device=SPI_NO_DEVICE;
+
+/* Bytes usable by the application, FLASH_SCRATCH_SECTORS sectors follow it:
+ * the rebuild counter sector then the scratch sectors */
+static uint32 g_capacity=0;
+
+/* Rebuilds counted in the first page of the counter sector, one cleared bit
+ * each, it picks the next scratch sector also after a reset */
+static uint16 g_rebuilds=0;
+
+/* Page cache */
+static uint8 g_cache[FLASH_PAGE_SIZE];
+static uint32 g_cache_page=0;
+static bool g_cache_valid=FALSE;
+static bool g_cache_dirty=FALSE;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_command
+ *  [Description] :		This function is responsible for selecting the flash and
+ *  					sending a command followed by a 24-bit address, chip
+ *  					select is left low for the data phase
+ *  [Args] :
+ *  [in]				uint8 a_command:
+ *  						command byte
+ *  					uint32 a_address:
+ *  						flash address
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void FLASH_command(uint8 a_command,uint32 a_address){
+	uint8 header[4];
+
+	header[0]=a_command;
+	header[1]=(uint8)(a_address>>16);
+	header[2]=(uint8)(a_address>>8);
+	header[3]=(uint8)(a_address);
+	SPI_select(g_device);
+	SPI_writeBurst(header,sizeof(header));
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_waitReady
+ *  [Description] :		This function is responsible for polling the status
+ *  					register until program or erase is finished
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void FLASH_waitReady(void){
+	uint8 status;
+
+	SPI_select(g_device);
+	SPI_sendByte(FLASH_CMD_READ_STATUS);
+	do{
+		SPI_readBurst(&status,1);
+	}while(status & FLASH_STATUS_BUSY);
+	SPI_deselect();
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_writeEnable
+ *  [Description] :		This function is responsible for sending write enable,
+ *  					needed before every program and erase
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void FLASH_writeEnable(void){
+	SPI_select(g_device);
+	SPI_sendByte(FLASH_CMD_WRITE_ENABLE);
+	SPI_deselect();
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_readRaw
+ *  [Description] :		This function is responsible for streaming bytes from the
+ *  					flash with fast read, the cache is not checked
+ *  [Args] :
+ *  [in]				uint32 a_address:
+ *  						first flash address
+ *  					uint16 a_length:
+ *  						number of bytes
+ *  [out]				uint8 *a_data_Ptr:
+ *  						pointer to address that data will be stored at
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void FLASH_readRaw(uint32 a_address,uint8 *a_data_Ptr,uint16 a_length){
+	FLASH_command(FLASH_CMD_FAST_READ,a_address);
+	/* Fast read needs one dummy byte before the data */
+	SPI_sendByte(SPI_DUMMY_BYTE);
+	SPI_readBurst(a_data_Ptr,a_length);
+	SPI_deselect();
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_programRaw
+ *  [Description] :		This function is responsible for programming bytes that
+ *  					lie inside one page and waiting for the end
+ *  [Args] :
+ *  [in]				uint32 a_address:
+ *  						first flash address
+ *  					const uint8 *a_data_Ptr:
+ *  						bytes to program
+ *  					uint16 a_length:
+ *  						number of bytes, must not cross a page
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void FLASH_programRaw(uint32 a_address,const uint8 *a_data_Ptr,uint16 a_length){
+	FLASH_writeEnable();
+	FLASH_command(FLASH_CMD_PAGE_PROGRAM,a_address);
+	SPI_writeBurst(a_data_Ptr,a_length);
+	SPI_deselect();
+	FLASH_waitReady();
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_eraseRaw
+ *  [Description] :		This function is responsible for sending an erase command
+ *  					and waiting for the end
+ *  [Args] :
+ *  [in]				uint8 a_command:
+ *  						sector or block erase command
+ *  					uint32 a_address:
+ *  						address inside the area
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void FLASH_eraseRaw(uint8 a_command,uint32 a_address){
+	FLASH_writeEnable();
+	FLASH_command(a_command,a_address);
+	SPI_deselect();
+	FLASH_waitReady();
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_copySector
+ *  [Description] :		This function is responsible for copying a sector into
+ *  					an erased one with one page program per page that is
+ *  					not erased, one page is skipped, FLASH_PAGE_SIZE bytes
+ *  					of stack are used
+ *  [Args] :
+ *  [in]				uint32 a_source:
+ *  						first address of the source sector
+ *  					uint32 a_destination:
+ *  						first address of the erased destination sector
+ *  					uint16 a_skip:
+ *  						offset of the page inside the sector not to copy
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void FLASH_copySector(uint32 a_source,uint32 a_destination,uint16 a_skip){
+	uint8 page[FLASH_PAGE_SIZE];
+	uint16 offset;
+	uint16 i;
+
+	for(offset=0;offset<FLASH_SECTOR_SIZE;offset+=FLASH_PAGE_SIZE){
+		if(offset==a_skip){
+			continue;
+		}
+		FLASH_readRaw(a_source+offset,page,FLASH_PAGE_SIZE);
+		/* Erased pages are already 0xFF in the destination */
+		for(i=0;i<FLASH_PAGE_SIZE;i++){
+			if(page[i]!=0xFF){
+				FLASH_programRaw(a_destination+offset,page,FLASH_PAGE_SIZE);
+				break;
+			}
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_nextScratch
+ *  [Description] :		This function is responsible for counting a rebuild in
+ *  					the counter sector and choosing its scratch sector, the
+ *  					scratch sectors are taken in turn
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			First address of the scratch sector
+ *********************************************************************************/
+static uint32 FLASH_nextScratch(void){
+	uint32 scratch;
+	uint8 mark;
+
+	if(g_rebuilds>=FLASH_PAGE_SIZE*8UL){
+		/* Counter page full, start it again */
+		FLASH_eraseRaw(FLASH_CMD_SECTOR_ERASE,g_capacity);
+		g_rebuilds=0;
+	}
+	scratch=g_capacity+(1UL+g_rebuilds%(FLASH_SCRATCH_SECTORS-1))*FLASH_SECTOR_SIZE;
+
+	/* Bits are cleared from the most significant one, programming can only
+	 * clear bits so the ones already cleared stay as they are */
+	mark=(uint8)(0xFF>>((g_rebuilds & 7)+1));
+	FLASH_programRaw(g_capacity+(g_rebuilds>>3),&mark,1);
+	g_rebuilds++;
+	return scratch;
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_dropCache
+ *  [Description] :		This function is responsible for forgetting the cached
+ *  					page when it lies in an erased area
+ *  [Args] :
+ *  [in]				uint32 a_start:
+ *  						first address of the area
+ *  					uint32 a_size:
+ *  						size of the area
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void FLASH_dropCache(uint32 a_start,uint32 a_size){
+	if(g_cache_valid && g_cache_page>=a_start && g_cache_page<(a_start+a_size)){
+		g_cache_valid=FALSE;
+		g_cache_dirty=FALSE;
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_init
+ *  [Description] :		This function is responsible for probing the flash with
+ *  					its JEDEC ID and taking the size from it, SPI_initMaster
+ *  					and SPI_initDevices must be called first
+ *  [Args] :
+ *  [in]				uint8 a_device:
+ *  						index of the flash in the SPI_initDevices table
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Success when a flash with 24-bit addressing answered
+ *  					Error if nothing answered
+ *********************************************************************************/
+uint8 FLASH_init(uint8 a_device){
+	FLASH_IdType id;
+	uint16 i;
+	uint8 bit;
+
+	g_device=a_device;
+	g_cache_valid=FALSE;
+	g_cache_dirty=FALSE;
+	g_capacity=0;
+
+	FLASH_readId(&id);
+	if(id.s_manufacturer==0x00 || id.s_manufacturer==0xFF){
+		return ERROR;
+	}
+	/* 64KB up to 16MB, bigger parts need 32-bit addresses */
+	if(id.s_capacity<16 || id.s_capacity>24){
+		return ERROR;
+	}
+
+	g_capacity=(1UL<<id.s_capacity)-FLASH_SCRATCH_SECTORS*FLASH_SECTOR_SIZE;
+
+	/* Every cleared bit of the counter page is one rebuild, the cache is free */
+	FLASH_readRaw(g_capacity,g_cache,FLASH_PAGE_SIZE);
+	g_rebuilds=0;
+	for(i=0;i<FLASH_PAGE_SIZE;i++){
+		for(bit=0;bit<8;bit++){
+			if(BIT_IS_CLEAR(g_cache[i],bit)){
+				g_rebuilds++;
+			}
+		}
+	}
+	return SUCCESS;
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_readId
+ *  [Description] :		This function is responsible for reading the JEDEC ID
+ *  [Args] :
+ *  [in]				None
+ *  [out]				FLASH_IdType *a_id_Ptr:
+ *  						pointer to structure the ID is stored at
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void FLASH_readId(FLASH_IdType *a_id_Ptr){
+	uint8 id[3];
+
+	SPI_select(g_device);
+	SPI_sendByte(FLASH_CMD_JEDEC_ID);
+	SPI_readBurst(id,sizeof(id));
+	SPI_deselect();
+
+	a_id_Ptr->s_manufacturer=id[0];
+	a_id_Ptr->s_memory_type=id[1];
+	a_id_Ptr->s_capacity=id[2];
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_getCapacity
+ *  [Description] :		This function is responsible for returning the bytes
+ *  					usable by FLASH_read and FLASH_write
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Chip size minus the FLASH_SCRATCH_SECTORS kept sectors,
+ *  					0 before FLASH_init
+ *********************************************************************************/
+uint32 FLASH_getCapacity(void){
+	return g_capacity;
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_read
+ *  [Description] :		This function is responsible for reading bytes from any
+ *  					address, bytes of the cached page come from RAM
+ *  [Args] :
+ *  [in]				uint32 a_address:
+ *  						first address
+ *  					uint16 a_length:
+ *  						number of bytes
+ *  [out]				uint8 *a_data_Ptr:
+ *  						pointer to address that data will be stored at
+ *  [in/out]			None
+ *  [Returns]			Success if the range is inside the flash
+ *  					Error if not
+ *********************************************************************************/
+uint8 FLASH_read(uint32 a_address,uint8 *a_data_Ptr,uint16 a_length){
+	uint32 page;
+	uint16 offset;
+	uint16 count;
+	uint16 i;
+
+	if(a_address+a_length>g_capacity){
+		return ERROR;
+	}
+
+	while(a_length>0){
+		page=a_address & ~(FLASH_PAGE_SIZE-1);
+		offset=(uint16)(a_address-page);
+		count=FLASH_PAGE_SIZE-offset;
+		if(count>a_length){
+			count=a_length;
+		}
+
+		if(g_cache_valid && page==g_cache_page){
+			for(i=0;i<count;i++){
+				a_data_Ptr[i]=g_cache[offset+i];
+			}
+		}
+		else{
+			FLASH_readRaw(a_address,a_data_Ptr,count);
+		}
+
+		a_address+=count;
+		a_data_Ptr+=count;
+		a_length-=count;
+	}
+	return SUCCESS;
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_write
+ *  [Description] :		This function is responsible for writing bytes to any
+ *  					address, writes to the same page are collected in RAM
+ *  					and reach the flash when another page is written or on
+ *  					FLASH_flush
+ *  [Args] :
+ *  [in]				uint32 a_address:
+ *  						first address
+ *  					const uint8 *a_data_Ptr:
+ *  						bytes to write
+ *  					uint16 a_length:
+ *  						number of bytes
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Success if the range is inside the flash
+ *  					Error if not
+ *********************************************************************************/
+uint8 FLASH_write(uint32 a_address,const uint8 *a_data_Ptr,uint16 a_length){
+	uint32 page;
+	uint16 offset;
+	uint16 count;
+	uint16 i;
+
+	if(a_address+a_length>g_capacity){
+		return ERROR;
+	}
+
+	while(a_length>0){
+		page=a_address & ~(FLASH_PAGE_SIZE-1);
+		if(!g_cache_valid || page!=g_cache_page){
+			FLASH_flush();
+			FLASH_readRaw(page,g_cache,FLASH_PAGE_SIZE);
+			g_cache_page=page;
+			g_cache_valid=TRUE;
+		}
+
+		offset=(uint16)(a_address-page);
+		count=FLASH_PAGE_SIZE-offset;
+		if(count>a_length){
+			count=a_length;
+		}
+		for(i=0;i<count;i++){
+			g_cache[offset+i]=a_data_Ptr[i];
+		}
+		g_cache_dirty=TRUE;
+
+		a_address+=count;
+		a_data_Ptr+=count;
+		a_length-=count;
+	}
+	return SUCCESS;
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_flush
+ *  [Description] :		This function is responsible for writing the cached page
+ *  					to the flash, programmed directly when it only clears
+ *  					bits else its sector is erased and rebuilt through the
+ *  					scratch sector
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Success
+ *********************************************************************************/
+uint8 FLASH_flush(void){
+	uint8 chunk[FLASH_CHUNK_SIZE];
+	uint32 sector;
+	uint32 scratch;
+	uint16 offset;
+	uint8 i;
+	bool erase=FALSE;
+
+	if(!g_cache_valid || !g_cache_dirty){
+		return SUCCESS;
+	}
+
+	/* Programming can only turn bits from 1 to 0 */
+	for(offset=0;offset<FLASH_PAGE_SIZE && !erase;offset+=FLASH_CHUNK_SIZE){
+		FLASH_readRaw(g_cache_page+offset,chunk,FLASH_CHUNK_SIZE);
+		for(i=0;i<FLASH_CHUNK_SIZE;i++){
+			if(g_cache[offset+i] & (~chunk[i])){
+				erase=TRUE;
+				break;
+			}
+		}
+	}
+
+	if(erase){
+		sector=g_cache_page & ~(FLASH_SECTOR_SIZE-1);
+		offset=(uint16)(g_cache_page-sector);
+		scratch=FLASH_nextScratch();
+		FLASH_eraseRaw(FLASH_CMD_SECTOR_ERASE,scratch);
+		FLASH_copySector(sector,scratch,offset);
+		FLASH_eraseRaw(FLASH_CMD_SECTOR_ERASE,sector);
+		FLASH_copySector(scratch,sector,offset);
+	}
+	FLASH_programRaw(g_cache_page,g_cache,FLASH_PAGE_SIZE);
+
+	g_cache_dirty=FALSE;
+	return SUCCESS;
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_eraseSector
+ *  [Description] :		This function is responsible for erasing the 4KB sector
+ *  					holding an address, a cached page inside it is dropped
+ *  [Args] :
+ *  [in]				uint32 a_address:
+ *  						any address inside the sector
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Success if the address is inside the flash
+ *  					Error if not
+ *********************************************************************************/
+uint8 FLASH_eraseSector(uint32 a_address){
+	if(a_address>=g_capacity){
+		return ERROR;
+	}
+	a_address&=~(FLASH_SECTOR_SIZE-1);
+	FLASH_dropCache(a_address,FLASH_SECTOR_SIZE);
+	FLASH_eraseRaw(FLASH_CMD_SECTOR_ERASE,a_address);
+	return SUCCESS;
+}
+
+/********************************************************************************
+ *  [Function Name]:	FLASH_eraseBlock
+ *  [Description] :		This function is responsible for erasing the 64KB block
+ *  					holding an address, a cached page inside it is dropped
+ *  [Args] :
+ *  [in]				uint32 a_address:
+ *  						any address inside the block
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Success if the address is inside the flash
+ *  					Error if not
+ *********************************************************************************/
+uint8 FLASH_eraseBlock(uint32 a_address){
+	if(a_address>=g_capacity){
+		return ERROR;
+	}
+	a_address&=~(FLASH_BLOCK_SIZE-1);
+	FLASH_dropCache(a_address,FLASH_BLOCK_SIZE);
+	FLASH_eraseRaw(FLASH_CMD_BLOCK_ERASE,a_address);
+	return SUCCESS;
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<flash.h>
+ *
+ * [MODULE]:		<FLASH>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Header file for the W25Qxx SPI NOR flash driver>
+ *
+ *******************************************************************************/
+#ifndef FLASH_H_
+#define FLASH_H_
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "spi.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Answer of the JEDEC ID command */
+typedef struct
+{
+	uint8 s_manufacturer;		/* 0xEF for Winbond */
+	uint8 s_memory_type;
+	uint8 s_capacity;			/* Size is 2^s_capacity bytes */
+}FLASH_IdType;
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+#define ERROR 0
+#define SUCCESS 1
+
+/* Flash geometry */
+#define FLASH_PAGE_SIZE   256UL
+#define FLASH_SECTOR_SIZE 4096UL
+#define FLASH_BLOCK_SIZE  65536UL
+
+/* Bytes read per step when the cached page is compared with the flash */
+#define FLASH_CHUNK_SIZE 32
+
+/* Sectors kept at the end of the chip for rebuilding a sector whose page needs
+ * bits set back to 1: a rebuild counter, then FLASH_SCRATCH_SECTORS-1 scratch
+ * sectors used in turn. Each scratch sector is erased once per
+ * (FLASH_SCRATCH_SECTORS-1) rebuilds of the whole chip, so at 100000 erase
+ * cycles per sector the scratch sectors last about 700000 rebuilds with 8.
+ * The counter sector is erased once per 2048 rebuilds. A rebuilt data sector
+ * is erased once each time it is rebuilt itself */
+#define FLASH_SCRATCH_SECTORS 8UL
+
+#if FLASH_SCRATCH_SECTORS<2
+#error "FLASH_SCRATCH_SECTORS needs the counter and at least one scratch sector"
+#endif
+
+/* Commands */
+#define FLASH_CMD_WRITE_ENABLE	0x06
+#define FLASH_CMD_READ_STATUS	0x05
+#define FLASH_CMD_PAGE_PROGRAM	0x02
+#define FLASH_CMD_FAST_READ		0x0B
+#define FLASH_CMD_SECTOR_ERASE	0x20
+#define FLASH_CMD_BLOCK_ERASE	0xD8
+#define FLASH_CMD_JEDEC_ID		0x9F
+
+/* Status register busy bit */
+#define FLASH_STATUS_BUSY 0x01
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/* This function is responsible for probing the flash on a device of the SPI table */
+uint8 FLASH_init(uint8 a_device);
+
+/* This function is responsible for reading the JEDEC ID */
+void FLASH_readId(FLASH_IdType *a_id_Ptr);
+
+/* This function is responsible for returning the bytes usable by FLASH_read/FLASH_write */
+uint32 FLASH_getCapacity(void);
+
+/* This function is responsible for reading bytes from any address */
+uint8 FLASH_read(uint32 a_address,uint8 *a_data_Ptr,uint16 a_length);
+
+/* This function is responsible for writing bytes to any address through the page cache */
+uint8 FLASH_write(uint32 a_address,const uint8 *a_data_Ptr,uint16 a_length);
+
+/* This function is responsible for writing the cached page to the flash */
+uint8 FLASH_flush(void);
+
+/* This function is responsible for erasing the 4KB sector holding an address */
+uint8 FLASH_eraseSector(uint32 a_address);
+
+/* This function is responsible for erasing the 64KB block holding an address */
+uint8 FLASH_eraseBlock(uint32 a_address);
+
+#endif /* FLASH_H_ */
@@ -0,0 +1,52 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<format.h>
+ *
+ * [MODULE]:		<FORMAT>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Header file for the small formatted output engine>
+ *
+ *******************************************************************************/
+#ifndef FORMAT_H_
+#define FORMAT_H_
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+/* for va_list */
+#include <stdarg.h>
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Output function taking one character, e.g. UART_sendByte or LCD_displayCharacter */
+typedef void(*FORMAT_Sink)(uint8 a_character);
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Most digits %q may print after the point */
+#define FORMAT_MAX_FRACTION 9
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/* This function is responsible for printing formatted text one character at a time
+ * Supported: %d %u %x %X %s %c %q %%, flags '-' '0', width, precision, 'l' for 32 bits
+ * %.Nq prints an integer scaled by 10^N as fixed point, %.2q of 1234 ----> 12.34 */
+void FORMAT_print(FORMAT_Sink a_sink_Ptr,const char *a_format_Ptr,...);
+
+/* This function is responsible for the same job as FORMAT_print with a va_list */
+void FORMAT_vprint(FORMAT_Sink a_sink_Ptr,const char *a_format_Ptr,va_list a_args);
+
+#endif /* FORMAT_H_ */
@@ -15,7 +15,7 @@
 
 /* Setting clock of Micro to 1MHZ */
 #ifndef F_CPU
-#define F_CPU 8000000UL
+#define F_CPU 1000000UL
 #endif
 
 /* For Macros ROR and ROL */
@@ -0,0 +1,305 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<format.c>
+ *
+ * [MODULE]:		<FORMAT>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Source file for the small formatted output engine>
+ * 					<Characters go straight to the sink, no heap and no line buffer>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "format.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Flags of one conversion */
+#define FORMAT_LEFT		0x01
+#define FORMAT_ZERO		0x02
+#define FORMAT_UPPER	0x04
+
+/* Digits of a 32 bit number plus point and leading zero */
+#define FORMAT_DIGITS_SIZE 12
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	FORMAT_pad
+ *  [Description] :		This function is responsible for sending a character
+ *  					a number of times
+ *  [Args] :
+ *  [in]				FORMAT_Sink a_sink_Ptr:
+ *  						output function
+ *  					uint8 a_character:
+ *  						padding character
+ *  					uint8 a_count:
+ *  						number of times
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void FORMAT_pad(FORMAT_Sink a_sink_Ptr,uint8 a_character,uint8 a_count){
+	while(a_count!=0){
+		(*a_sink_Ptr)(a_character);
+		a_count--;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	FORMAT_number
+ *  [Description] :		This function is responsible for printing a number with
+ *  					sign, padding and an optional decimal point
+ *  [Args] :
+ *  [in]				FORMAT_Sink a_sink_Ptr:
+ *  						output function
+ *  					uint32 a_value:
+ *  						magnitude of the number
+ *  					uint8 a_base:
+ *  						10 or 16
+ *  					bool a_negative:
+ *  						TRUE to print a minus sign
+ *  					uint8 a_width:
+ *  						minimum field width
+ *  					uint8 a_flags:
+ *  						FORMAT_LEFT, FORMAT_ZERO and FORMAT_UPPER
+ *  					uint8 a_fraction:
+ *  						digits after the decimal point, 0 for none
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void FORMAT_number(FORMAT_Sink a_sink_Ptr,uint32 a_value,uint8 a_base,bool a_negative,
+		uint8 a_width,uint8 a_flags,uint8 a_fraction){
+	/* Digits are made last first */
+	uint8 digits[FORMAT_DIGITS_SIZE];
+	uint8 count=0;
+	uint8 produced=0;
+	uint8 length;
+	uint8 digit;
+	uint16 small;
+
+	do{
+		if(a_fraction!=0 && produced==a_fraction){
+			digits[count++]='.';
+		}
+		if(a_base==16){
+			digit=a_value & 0x0F;
+			a_value>>=4;
+		}
+		else if(a_value<=0xFFFF){
+			/* 16 bit division is much cheaper on AVR */
+			small=(uint16)a_value;
+			digit=small%10;
+			a_value=small/10;
+		}
+		else{
+			digit=a_value%10;
+			a_value/=10;
+		}
+		if(digit<10){
+			digits[count++]='0'+digit;
+		}
+		else{
+			digits[count++]=((a_flags & FORMAT_UPPER)?'A':'a')+digit-10;
+		}
+		produced++;
+	}while(a_value!=0 || produced<=a_fraction);
+
+	length=count+(a_negative?1:0);
+
+	if(!(a_flags & (FORMAT_LEFT | FORMAT_ZERO)) && a_width>length){
+		FORMAT_pad(a_sink_Ptr,' ',a_width-length);
+	}
+	if(a_negative){
+		(*a_sink_Ptr)('-');
+	}
+	if((a_flags & FORMAT_ZERO) && !(a_flags & FORMAT_LEFT) && a_width>length){
+		FORMAT_pad(a_sink_Ptr,'0',a_width-length);
+	}
+	while(count!=0){
+		count--;
+		(*a_sink_Ptr)(digits[count]);
+	}
+	if((a_flags & FORMAT_LEFT) && a_width>length){
+		FORMAT_pad(a_sink_Ptr,' ',a_width-length);
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	FORMAT_vprint
+ *  [Description] :		This function is responsible for printing formatted text
+ *  					through the sink one character at a time
+ *  [Args] :
+ *  [in]				FORMAT_Sink a_sink_Ptr:
+ *  						output function
+ *  					const char *a_format_Ptr:
+ *  						format string
+ *  					va_list a_args:
+ *  						values for the conversions
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void FORMAT_vprint(FORMAT_Sink a_sink_Ptr,const char *a_format_Ptr,va_list a_args){
+	uint8 character;
+	uint8 flags;
+	uint8 width;
+	uint8 precision;
+	bool hasPrecision;
+	bool isLong;
+	bool negative;
+	uint32 value;
+	sint32 signedValue;
+	const char *string_Ptr;
+	uint16 length;
+
+	while((character=*a_format_Ptr++)!='\0'){
+		if(character!='%'){
+			(*a_sink_Ptr)(character);
+			continue;
+		}
+
+		/* Flags */
+		flags=0;
+		for(;;){
+			if(*a_format_Ptr=='-'){
+				flags|=FORMAT_LEFT;
+			}
+			else if(*a_format_Ptr=='0'){
+				flags|=FORMAT_ZERO;
+			}
+			else{
+				break;
+			}
+			a_format_Ptr++;
+		}
+
+		/* Width */
+		width=0;
+		while(*a_format_Ptr>='0' && *a_format_Ptr<='9'){
+			width=width*10+(*a_format_Ptr++-'0');
+		}
+
+		/* Precision */
+		precision=0;
+		hasPrecision=FALSE;
+		if(*a_format_Ptr=='.'){
+			a_format_Ptr++;
+			hasPrecision=TRUE;
+			while(*a_format_Ptr>='0' && *a_format_Ptr<='9'){
+				precision=precision*10+(*a_format_Ptr++-'0');
+			}
+		}
+
+		/* Length */
+		isLong=FALSE;
+		if(*a_format_Ptr=='l'){
+			isLong=TRUE;
+			a_format_Ptr++;
+		}
+
+		character=*a_format_Ptr++;
+		switch(character){
+
+		case 'd':
+		case 'q':
+			signedValue=isLong?va_arg(a_args,sint32):(sint32)va_arg(a_args,int);
+			negative=(signedValue<0);
+			value=negative?(0UL-(uint32)signedValue):(uint32)signedValue;
+			if(character=='d' || precision>FORMAT_MAX_FRACTION){
+				precision=(character=='d')?0:FORMAT_MAX_FRACTION;
+			}
+			FORMAT_number(a_sink_Ptr,value,10,negative,width,flags,precision);
+			break;
+
+		case 'u':
+			value=isLong?va_arg(a_args,uint32):(uint32)va_arg(a_args,unsigned int);
+			FORMAT_number(a_sink_Ptr,value,10,FALSE,width,flags,0);
+			break;
+
+		case 'X':
+			flags|=FORMAT_UPPER;
+			/* fall through */
+		case 'x':
+			value=isLong?va_arg(a_args,uint32):(uint32)va_arg(a_args,unsigned int);
+			FORMAT_number(a_sink_Ptr,value,16,FALSE,width,flags,0);
+			break;
+
+		case 's':
+			string_Ptr=va_arg(a_args,const char *);
+			length=0;
+			while(string_Ptr[length]!='\0' && (!hasPrecision || length<precision)){
+				length++;
+			}
+			if(!(flags & FORMAT_LEFT) && width>length){
+				FORMAT_pad(a_sink_Ptr,' ',width-length);
+			}
+			for(value=0;value<length;value++){
+				(*a_sink_Ptr)(string_Ptr[value]);
+			}
+			if((flags & FORMAT_LEFT) && width>length){
+				FORMAT_pad(a_sink_Ptr,' ',width-length);
+			}
+			break;
+
+		case 'c':
+			if(!(flags & FORMAT_LEFT) && width>1){
+				FORMAT_pad(a_sink_Ptr,' ',width-1);
+			}
+			(*a_sink_Ptr)((uint8)va_arg(a_args,int));
+			if((flags & FORMAT_LEFT) && width>1){
+				FORMAT_pad(a_sink_Ptr,' ',width-1);
+			}
+			break;
+
+		case '\0':
+			/* Format ended after '%' */
+			return;
+
+		default:
+			/* "%%" and unknown conversions are printed as they are */
+			if(character!='%'){
+				(*a_sink_Ptr)('%');
+			}
+			(*a_sink_Ptr)(character);
+			break;
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	FORMAT_print
+ *  [Description] :		This function is responsible for printing formatted text
+ *  					through the sink one character at a time
+ *  [Args] :
+ *  [in]				FORMAT_Sink a_sink_Ptr:
+ *  						output function
+ *  					const char *a_format_Ptr:
+ *  						format string followed by the values
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void FORMAT_print(FORMAT_Sink a_sink_Ptr,const char *a_format_Ptr,...){
+	va_list args;
+
+	va_start(args,a_format_Ptr);
+	FORMAT_vprint(a_sink_Ptr,a_format_Ptr,args);
+	va_end(args);
+}
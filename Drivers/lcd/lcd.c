@@ -325,12 +325,6 @@ void LCD_clearScreen(void){
  *************************************************************************************/
 
 void LCD_integerToString(uint32 a_data){
-	/* array of 16 chars as LCD take 16 in one line */
-	uint8 string[LCD_WIDTH];
-
-	/* function to convert integer data to string with base 10 */
-	itoa(a_data,string,10);
-
-	/* Display data */
-	LCD_displayString(string);
+	/* Digits go straight to the LCD, no string buffer needed */
+	FORMAT_print(LCD_displayCharacter,"%lu",a_data);
 }
@@ -22,8 +22,8 @@
 #include "micro_config.h"
 #include "std_types.h"
 #include "common_macros.h"
-/* for the use of itoa() function */
-#include "stdlib.h"
+/* for printing numbers without itoa() */
+#include "format.h"
 
 /*******************************************************************************
  *                      Preprocessor Macros                                    *
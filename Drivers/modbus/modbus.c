@@ -0,0 +1,499 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<modbus.c>
+ *
+ * [MODULE]:		<MODBUS>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Source file for the Modbus RTU slave over RS-485>
+ * 					<Frames are split by silence measured with TIMER1 compare A (3.5 chars)>
+ * 					<and compare B (1.5 chars plus the next character), restarted on>
+ * 					<every received byte>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "timer.h"
+#include "modbus.h"
+
+/* For reading statistics shared with the ISR */
+#include <util/atomic.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Any id other than TIMER0..TIMER2 selects the TIMER1 compare B call back */
+#define MODBUS_TIMER1B_ID 3
+
+/* Bits per RTU character: start + 8 data + parity or 2nd stop + stop */
+#define MODBUS_CHAR_BITS 11UL
+
+/* Above 19200 baud the standard fixes the gaps to 750us and 1750us */
+#define MODBUS_FIXED_GAP_BAUD 19200UL
+
+/* Largest register counts that fit the frame buffer */
+#define MODBUS_MAX_READ		(((MODBUS_BUFFER_SIZE-5)/2 < 125) ? (MODBUS_BUFFER_SIZE-5)/2 : 125)
+#define MODBUS_MAX_WRITE	(((MODBUS_BUFFER_SIZE-9)/2 < 123) ? (MODBUS_BUFFER_SIZE-9)/2 : 123)
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	MODBUS_IDLE,MODBUS_RECEIVING,MODBUS_FRAME_READY,MODBUS_TRANSMITTING
+}MODBUS_State;
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+/* Global pointer to store address of initialization structure */
+static const MODBUS_ConfigType *g_modbus_config_Ptr=NULL_PTR;
+
+/* TIMER1 setting calculated from the baud rate, started on first byte of a frame */
+static Timer_ConfigType g_gapTimer;
+
+/* Request and reply share one buffer */
+static uint8 g_frame[MODBUS_BUFFER_SIZE];
+static volatile uint16 g_frameLength=0;
+
+static volatile MODBUS_State g_state=MODBUS_IDLE;
+
+/* Set by compare B when 1.5 chars of silence passed inside the frame */
+static volatile bool g_gap15=FALSE;
+
+/* Set when the frame has to be dropped at its end */
+static volatile bool g_frameError=FALSE;
+
+static volatile MODBUS_StatsType g_stats;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	MODBUS_receiveHandler
+ *  [Description] :		This function is responsible for storing one byte and
+ *  					restarting the gap timer, it runs inside USART_RXC_vect
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						received byte
+ *  					uint8 a_status:
+ *  						UART error flags of the byte
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void MODBUS_receiveHandler(uint8 a_data,uint8 a_status){
+	uint16 length;
+
+	if(g_state==MODBUS_IDLE){
+		/* First byte of a frame starts the gap timer */
+		g_frameLength=0;
+		g_gap15=FALSE;
+		g_frameError=FALSE;
+		g_state=MODBUS_RECEIVING;
+		TIMER_init(&g_gapTimer);
+	}
+	else if(g_state==MODBUS_RECEIVING){
+		TIMER_restart(TIMER1);
+		if(g_gap15){
+			/* Silence longer than 1.5 chars inside a frame */
+			g_frameError=TRUE;
+		}
+	}
+	else{
+		/* Previous frame not handled yet or own transmission */
+		return;
+	}
+
+	length=g_frameLength;
+	if(a_status!=0 || length>=MODBUS_BUFFER_SIZE){
+		g_frameError=TRUE;
+		return;
+	}
+	g_frame[length]=a_data;
+	g_frameLength=length+1;
+}
+
+/********************************************************************************
+ *  [Function Name]:	MODBUS_gap15
+ *  [Description] :		This function is responsible for marking 1.5 chars of
+ *  					silence, TIMER1 compare B call back
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void MODBUS_gap15(void){
+	g_gap15=TRUE;
+}
+
+/********************************************************************************
+ *  [Function Name]:	MODBUS_gap35
+ *  [Description] :		This function is responsible for ending the frame after
+ *  					3.5 chars of silence, TIMER1 compare A call back
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void MODBUS_gap35(void){
+	/* Stop the timer until the next frame starts */
+	TIMER_deinit(TIMER1);
+
+	if(g_state!=MODBUS_RECEIVING){
+		return;
+	}
+	if(g_frameError){
+		g_stats.s_gap_errors++;
+		g_state=MODBUS_IDLE;
+	}
+	else{
+		g_state=MODBUS_FRAME_READY;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	MODBUS_transmitComplete
+ *  [Description] :		This function is responsible for releasing the RS-485
+ *  					bus as soon as the last stop bit left, USART_TXC_vect
+ *  					call back
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void MODBUS_transmitComplete(void){
+	if(g_state==MODBUS_TRANSMITTING && UART_txPending()==0){
+		CLEAR_BIT(MODBUS_DE_PORT,MODBUS_DE_PIN);
+		g_state=MODBUS_IDLE;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	MODBUS_gapTicks
+ *  [Description] :		This function is responsible for converting a time in
+ *  					micro seconds to TIMER1 ticks at prescaler 1
+ *  [Args] :
+ *  [in]				uint32 a_time_us:
+ *  						time in micro seconds
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Number of ticks
+ *********************************************************************************/
+static uint32 MODBUS_gapTicks(uint32 a_time_us){
+	return (F_CPU/1000UL)*a_time_us/1000UL;
+}
+
+/********************************************************************************
+ *  [Function Name]:	MODBUS_getWord
+ *  [Description] :		This function is responsible for reading a big endian
+ *  					word from the frame
+ *  [Args] :
+ *  [in]				uint8 a_index:
+ *  						index of high byte
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			The word
+ *********************************************************************************/
+static uint16 MODBUS_getWord(uint8 a_index){
+	return ((uint16)g_frame[a_index]<<8) | g_frame[a_index+1];
+}
+
+/********************************************************************************
+ *  [Function Name]:	MODBUS_execute
+ *  [Description] :		This function is responsible for executing function codes
+ *  					3, 6 and 16 and building the reply in the frame buffer
+ *  [Args] :
+ *  [in]				uint16 a_length:
+ *  						request length without CRC
+ *  [out]				uint16 *a_reply_Ptr:
+ *  						reply length without CRC
+ *  [in/out]			None
+ *  [Returns]			Exception code or 0
+ *********************************************************************************/
+static uint8 MODBUS_execute(uint16 a_length,uint16 *a_reply_Ptr){
+	uint16 *registers_Ptr=g_modbus_config_Ptr->s_registers_Ptr;
+	uint16 start;
+	uint16 count;
+	uint16 i;
+
+	switch(g_frame[1]){
+
+	case MODBUS_READ_HOLDING_REGISTERS:
+		if(a_length!=6){
+			return MODBUS_ILLEGAL_DATA_VALUE;
+		}
+		start=MODBUS_getWord(2);
+		count=MODBUS_getWord(4);
+		if(count<1 || count>MODBUS_MAX_READ){
+			return MODBUS_ILLEGAL_DATA_VALUE;
+		}
+		if((uint32)start+count>g_modbus_config_Ptr->s_register_count){
+			return MODBUS_ILLEGAL_DATA_ADDRESS;
+		}
+		g_frame[2]=(uint8)(count*2);
+		for(i=0;i<count;i++){
+			g_frame[3+2*i]=(uint8)(registers_Ptr[start+i]>>8);
+			g_frame[4+2*i]=(uint8)registers_Ptr[start+i];
+		}
+		*a_reply_Ptr=3+2*count;
+		break;
+
+	case MODBUS_WRITE_SINGLE_REGISTER:
+		if(a_length!=6){
+			return MODBUS_ILLEGAL_DATA_VALUE;
+		}
+		start=MODBUS_getWord(2);
+		if(start>=g_modbus_config_Ptr->s_register_count){
+			return MODBUS_ILLEGAL_DATA_ADDRESS;
+		}
+		registers_Ptr[start]=MODBUS_getWord(4);
+		if(g_modbus_config_Ptr->s_write_callBack_Ptr!=NULL_PTR){
+			(*g_modbus_config_Ptr->s_write_callBack_Ptr)(start,1);
+		}
+		/* Reply echoes the request */
+		*a_reply_Ptr=6;
+		break;
+
+	case MODBUS_WRITE_MULTIPLE_REGISTERS:
+		if(a_length<7){
+			return MODBUS_ILLEGAL_DATA_VALUE;
+		}
+		start=MODBUS_getWord(2);
+		count=MODBUS_getWord(4);
+		if(count<1 || count>MODBUS_MAX_WRITE || g_frame[6]!=count*2 || a_length!=7+count*2){
+			return MODBUS_ILLEGAL_DATA_VALUE;
+		}
+		if((uint32)start+count>g_modbus_config_Ptr->s_register_count){
+			return MODBUS_ILLEGAL_DATA_ADDRESS;
+		}
+		for(i=0;i<count;i++){
+			registers_Ptr[start+i]=MODBUS_getWord(7+2*i);
+		}
+		if(g_modbus_config_Ptr->s_write_callBack_Ptr!=NULL_PTR){
+			(*g_modbus_config_Ptr->s_write_callBack_Ptr)(start,count);
+		}
+		/* Reply is address, function, start and count */
+		*a_reply_Ptr=6;
+		break;
+
+	default:
+		return MODBUS_ILLEGAL_FUNCTION;
+	}
+	return 0;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	MODBUS_init
+ *  [Description] :		This function is responsible for initializing UART, the
+ *  					RS-485 DE pin and the TIMER1 gap detector, global
+ *  					interrupts must be enabled by the application
+ *  [Args] :
+ *  [in]				const MODBUS_ConfigType *a_config_Ptr:
+ *  						pointer contains address of structure
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void MODBUS_init(const MODBUS_ConfigType *a_config_Ptr){
+	uint32 baudRate=a_config_Ptr->s_uart_config_Ptr->s_baudRate;
+	uint32 ticks15;
+	uint32 ticks35;
+	uint8 clock=F_CPU_1;
+	uint8 shift=0;
+
+	/* Storing pointer in global one */
+	g_modbus_config_Ptr=a_config_Ptr;
+	g_state=MODBUS_IDLE;
+
+	/* Receiver only until a reply is sent */
+	CLEAR_BIT(MODBUS_DE_PORT,MODBUS_DE_PIN);
+	SET_BIT(MODBUS_DE_DIR,MODBUS_DE_PIN);
+
+	/* Gap times are based on 11 bit characters. The timer restarts at RXC,
+	 * the end of a character, so the next RXC comes one character time after
+	 * the silence ends, compare B waits for that character on top of 1.5 */
+	if(baudRate>MODBUS_FIXED_GAP_BAUD){
+		ticks15=MODBUS_gapTicks(750UL+MODBUS_CHAR_BITS*1000000UL/baudRate);
+		ticks35=MODBUS_gapTicks(1750UL);
+	}
+	else{
+		ticks15=MODBUS_gapTicks(MODBUS_CHAR_BITS*2500000UL/baudRate);
+		ticks35=MODBUS_gapTicks(MODBUS_CHAR_BITS*3500000UL/baudRate);
+	}
+
+	/* Smallest prescaler that keeps 3.5 chars inside 16 bits */
+	while((ticks35>>shift)>0xFFFFUL && clock<F_CPU_1024){
+		clock++;
+		shift=(clock==F_CPU_8)?3:(clock==F_CPU_64)?6:(clock==F_CPU_256)?8:10;
+	}
+
+	g_gapTimer.s_timer_id=TIMER1;
+	g_gapTimer.s_timer_mode=CMP;
+	g_gapTimer.s_timer_clk=clock;
+	g_gapTimer.s_timer2_clk=NONE2;
+	g_gapTimer.s_timer_oco_mode=NONE_OCO;
+	g_gapTimer.s_timer_initial_value=0;
+	g_gapTimer.s_timer_compare_value=(uint16)(ticks35>>shift);
+	g_gapTimer.s_timer1B_compare_value=(uint16)(ticks15>>shift);
+
+	TIMER_setCallBack(TIMER1,MODBUS_gap35);
+	TIMER_setCallBack(MODBUS_TIMER1B_ID,MODBUS_gap15);
+
+	UART_init(a_config_Ptr->s_uart_config_Ptr);
+	UART_setReceiveHandler(MODBUS_receiveHandler);
+	UART_callBackAdress(MODBUS_transmitComplete,2);
+}
+
+/********************************************************************************
+ *  [Function Name]:	MODBUS_poll
+ *  [Description] :		This function is responsible for checking a received
+ *  					frame, executing it and sending the reply, call it from
+ *  					the main loop, it waits while a reply longer than the
+ *  					UART transmit buffer is queued
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void MODBUS_poll(void){
+	uint16 length;
+	uint16 reply=0;
+	uint16 sent;
+	uint16 room;
+	uint8 exception;
+	uint8 address;
+	uint16 crc=0xFFFF;
+	uint16 i;
+
+	if(g_state!=MODBUS_FRAME_READY){
+		return;
+	}
+	length=g_frameLength;
+
+	/* CRC over the whole frame including its own CRC leaves zero */
+	for(i=0;i<length;i++){
+		crc=MODBUS_crcUpdate(crc,g_frame[i]);
+	}
+	if(length<4 || crc!=0){
+		g_stats.s_crc_errors++;
+		g_state=MODBUS_IDLE;
+		return;
+	}
+
+	address=g_frame[0];
+	if(address!=g_modbus_config_Ptr->s_slave_address && address!=MODBUS_BROADCAST_ADDRESS){
+		/* Request for another slave */
+		g_state=MODBUS_IDLE;
+		return;
+	}
+
+	exception=MODBUS_execute(length-2,&reply);
+	g_stats.s_frames++;
+
+	if(address==MODBUS_BROADCAST_ADDRESS){
+		/* Broadcast is never answered */
+		g_state=MODBUS_IDLE;
+		return;
+	}
+
+	if(exception!=0){
+		g_frame[1]|=0x80;
+		g_frame[2]=exception;
+		reply=3;
+		g_stats.s_exceptions++;
+	}
+
+	crc=0xFFFF;
+	for(i=0;i<reply;i++){
+		crc=MODBUS_crcUpdate(crc,g_frame[i]);
+	}
+	/* Modbus sends the CRC low byte first */
+	g_frame[reply]=(uint8)crc;
+	g_frame[reply+1]=(uint8)(crc>>8);
+
+	/* Take the bus, USART_TXC_vect releases it after the last stop bit */
+	SET_BIT(MODBUS_DE_PORT,MODBUS_DE_PIN);
+	length=reply+2;
+	sent=0;
+	while(sent<length){
+		/* Queue only what fits so no byte is refused whatever the TX policy,
+		 * a reply longer than the transmit buffer waits here for room */
+		room=(UART_TX_BUFFER_SIZE-1)-UART_txPending();
+		if(room==0){
+			continue;
+		}
+		if(room>=length-sent){
+			/* Last part, from here the TXC call back may release the bus */
+			room=length-sent;
+			g_state=MODBUS_TRANSMITTING;
+		}
+		sent+=UART_write(&g_frame[sent],room);
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	MODBUS_getStats
+ *  [Description] :		This function is responsible for copying the slave
+ *  					statistics
+ *  [Args] :
+ *  [in]				None
+ *  [out]				MODBUS_StatsType *a_stats_Ptr:
+ *  						pointer to structure the statistics are copied to
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void MODBUS_getStats(MODBUS_StatsType *a_stats_Ptr){
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		a_stats_Ptr->s_frames=g_stats.s_frames;
+		a_stats_Ptr->s_crc_errors=g_stats.s_crc_errors;
+		a_stats_Ptr->s_gap_errors=g_stats.s_gap_errors;
+		a_stats_Ptr->s_exceptions=g_stats.s_exceptions;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	MODBUS_crcUpdate
+ *  [Description] :		This function is responsible for updating the Modbus
+ *  					CRC-16 (polynomial 0xA001 reflected) with one byte
+ *  [Args] :
+ *  [in]				uint16 a_crc:
+ *  						current CRC, start with 0xFFFF
+ *  					uint8 a_data:
+ *  						new byte
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Updated CRC
+ *********************************************************************************/
+uint16 MODBUS_crcUpdate(uint16 a_crc,uint8 a_data){
+	uint8 bit;
+
+	a_crc^=a_data;
+	for(bit=0;bit<8;bit++){
+		if(a_crc & 1){
+			a_crc=(a_crc>>1)^0xA001;
+		}
+		else{
+			a_crc>>=1;
+		}
+	}
+	return a_crc;
+}
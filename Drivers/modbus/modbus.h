@@ -0,0 +1,88 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<modbus.h>
+ *
+ * [MODULE]:		<MODBUS>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Header file for the Modbus RTU slave over RS-485>
+ *
+ *******************************************************************************/
+#ifndef MODBUS_H_
+#define MODBUS_H_
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "uart.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	const UART_ConfigType *s_uart_config_Ptr;	/* UART setting, RX must be INTTERRUPT */
+	uint8		s_slave_address;				/* 1 to 247 */
+	uint16		*s_registers_Ptr;				/* Holding register table */
+	uint16		s_register_count;
+	void		(*s_write_callBack_Ptr)(uint16 a_address,uint16 a_count);
+}MODBUS_ConfigType;
+
+typedef struct
+{
+	uint16 s_frames;		/* Requests answered or executed */
+	uint16 s_crc_errors;
+	uint16 s_gap_errors;	/* Frames with a 1.5 char gap, UART error or overflow */
+	uint16 s_exceptions;	/* Exception responses sent */
+}MODBUS_StatsType;
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* RS-485 driver enable pin, high while transmitting */
+#define MODBUS_DE_PORT	PORTD
+#define MODBUS_DE_DIR	DDRD
+#define MODBUS_DE_PIN	PD2
+
+/* Frame buffer size, 256 holds the largest RTU frame
+ * smaller sizes limit the register count per request */
+#define MODBUS_BUFFER_SIZE 128
+
+/* Function codes */
+#define MODBUS_READ_HOLDING_REGISTERS	0x03
+#define MODBUS_WRITE_SINGLE_REGISTER	0x06
+#define MODBUS_WRITE_MULTIPLE_REGISTERS	0x10
+
+/* Exception codes */
+#define MODBUS_ILLEGAL_FUNCTION		0x01
+#define MODBUS_ILLEGAL_DATA_ADDRESS	0x02
+#define MODBUS_ILLEGAL_DATA_VALUE	0x03
+
+/* Address every slave executes without replying */
+#define MODBUS_BROADCAST_ADDRESS 0
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/* This function is responsible for initializing UART, TIMER1 and the DE pin */
+void MODBUS_init(const MODBUS_ConfigType *a_config_Ptr);
+
+/* This function is responsible for executing a received request and sending the reply */
+void MODBUS_poll(void);
+
+/* This function is responsible for copying the slave statistics */
+void MODBUS_getStats(MODBUS_StatsType *a_stats_Ptr);
+
+/* This function is responsible for updating the Modbus CRC with one byte */
+uint16 MODBUS_crcUpdate(uint16 a_crc,uint8 a_data);
+
+#endif /* MODBUS_H_ */
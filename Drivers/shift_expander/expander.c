@@ -0,0 +1,291 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<expander.c>
+ *
+ * [MODULE]:		<EXPANDER>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Source file for the 74HC595/74HC165 shift-register I/O expander>
+ * 					<Pins only change the shadow image, one queued SPI burst
+ * 					 moves every register and the chip select edge latches>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "timer.h"
+#include "expander.h"
+
+/* For sharing the busy flag with the TIMER2 refresh */
+#include <util/atomic.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Bytes clocked per refresh, the longer of the two chains */
+#if (EXPANDER_OUTPUT_BYTES > EXPANDER_INPUT_BYTES)
+#define EXPANDER_CHAIN_BYTES EXPANDER_OUTPUT_BYTES
+#else
+#define EXPANDER_CHAIN_BYTES EXPANDER_INPUT_BYTES
+#endif
+
+/* Compare value of TIMER2 with F_CPU/1024 for one tick */
+#define EXPANDER_TICK_COMPARE ((F_CPU/1024UL)*EXPANDER_TICK_MS/1000UL)
+
+#if (EXPANDER_TICK_COMPARE < 1) || (EXPANDER_TICK_COMPARE > 255)
+#error "EXPANDER_TICK_MS can not be made with TIMER2 at F_CPU/1024"
+#endif
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+/* Outputs kept in wire order, first byte sent ends in the last 595 so
+ * register i is at g_output[EXPANDER_CHAIN_BYTES-1-i] */
+static uint8 g_output[EXPANDER_CHAIN_BYTES];
+
+/* Inputs in wire order, register i (nearest to MISO first) is g_input[i] */
+static uint8 g_input[EXPANDER_CHAIN_BYTES];
+
+static SPI_TransactionType g_refresh;
+static volatile bool g_dirty=FALSE;
+static volatile bool g_busy=FALSE;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	EXPANDER_done
+ *  [Description] :		This function is responsible for marking the burst as
+ *  					finished, chip select going high has latched the 595s
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void EXPANDER_done(void){
+	g_busy=FALSE;
+}
+
+/********************************************************************************
+ *  [Function Name]:	EXPANDER_tick
+ *  [Description] :		This function is responsible for the periodic refresh,
+ *  					TIMER2 call back
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void EXPANDER_tick(void){
+#if (EXPANDER_INPUT_BYTES == 0)
+	/* Nothing to sample, only send when outputs changed */
+	if(!g_dirty){
+		return;
+	}
+#endif
+	EXPANDER_flush();
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	EXPANDER_init
+ *  [Description] :		This function is responsible for clearing the images
+ *  					and driving all outputs low, SPI_initMaster,
+ *  					SPI_initDevices and SPI_initQueue must be called first
+ *  					and interrupts enabled
+ *  [Args] :
+ *  [in]				uint8 a_device:
+ *  						SPI table index, its chip select pin is the latch
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void EXPANDER_init(uint8 a_device){
+	uint8 i;
+
+	for(i=0;i<EXPANDER_CHAIN_BYTES;i++){
+		g_output[i]=0;
+		g_input[i]=0;
+	}
+
+	g_refresh.s_device=a_device;
+	g_refresh.s_tx_Ptr=g_output;
+	g_refresh.s_rx_Ptr=g_input;
+	g_refresh.s_length=EXPANDER_CHAIN_BYTES;
+	g_refresh.s_priority=SPI_QUEUE_PRIORITIES-1;
+	g_refresh.s_done_callBack_Ptr=EXPANDER_done;
+
+	SET_BIT(EXPANDER_LOAD_PORT,EXPANDER_LOAD);
+	SET_BIT(EXPANDER_LOAD_DDR,EXPANDER_LOAD);
+
+	g_busy=FALSE;
+	g_dirty=TRUE;
+	EXPANDER_flush();
+}
+
+/********************************************************************************
+ *  [Function Name]:	EXPANDER_setPin
+ *  [Description] :		This function is responsible for setting an output pin
+ *  					in the shadow image, no bus access
+ *  [Args] :
+ *  [in]				uint8 a_pin:
+ *  						pin number, 8*register+bit
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void EXPANDER_setPin(uint8 a_pin){
+	if((a_pin>>3)<EXPANDER_OUTPUT_BYTES){
+		SET_BIT(g_output[EXPANDER_CHAIN_BYTES-1-(a_pin>>3)],(a_pin & 0x07));
+		g_dirty=TRUE;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	EXPANDER_clearPin
+ *  [Description] :		This function is responsible for clearing an output pin
+ *  					in the shadow image, no bus access
+ *  [Args] :
+ *  [in]				uint8 a_pin:
+ *  						pin number, 8*register+bit
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void EXPANDER_clearPin(uint8 a_pin){
+	if((a_pin>>3)<EXPANDER_OUTPUT_BYTES){
+		CLEAR_BIT(g_output[EXPANDER_CHAIN_BYTES-1-(a_pin>>3)],(a_pin & 0x07));
+		g_dirty=TRUE;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	EXPANDER_writeByte
+ *  [Description] :		This function is responsible for writing a whole output
+ *  					register in the shadow image, no bus access
+ *  [Args] :
+ *  [in]				uint8 a_index:
+ *  						register number, 0 is nearest to MOSI
+ *  					uint8 a_value:
+ *  						register value
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void EXPANDER_writeByte(uint8 a_index,uint8 a_value){
+	if(a_index<EXPANDER_OUTPUT_BYTES){
+		g_output[EXPANDER_CHAIN_BYTES-1-a_index]=a_value;
+		g_dirty=TRUE;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	EXPANDER_readPin
+ *  [Description] :		This function is responsible for reading an input pin as
+ *  					sampled by the last refresh
+ *  [Args] :
+ *  [in]				uint8 a_pin:
+ *  						pin number, 8*register+bit
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Pin level, LOW for pins out of the chain
+ *********************************************************************************/
+uint8 EXPANDER_readPin(uint8 a_pin){
+	if((a_pin>>3)<EXPANDER_INPUT_BYTES){
+		return BIT_IS_SET(g_input[a_pin>>3],(a_pin & 0x07));
+	}
+	return LOW;
+}
+
+/********************************************************************************
+ *  [Function Name]:	EXPANDER_readByte
+ *  [Description] :		This function is responsible for reading a whole input
+ *  					register as sampled by the last refresh
+ *  [Args] :
+ *  [in]				uint8 a_index:
+ *  						register number, 0 is nearest to MISO
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Register value, 0 for registers out of the chain
+ *********************************************************************************/
+uint8 EXPANDER_readByte(uint8 a_index){
+	if(a_index<EXPANDER_INPUT_BYTES){
+		return g_input[a_index];
+	}
+	return 0;
+}
+
+/********************************************************************************
+ *  [Function Name]:	EXPANDER_flush
+ *  [Description] :		This function is responsible for loading the 165s and
+ *  					queuing one burst for the whole chain, the chip select
+ *  					rising edge at its end latches the 595s
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			FALSE when the previous burst is still running
+ *********************************************************************************/
+bool EXPANDER_flush(void){
+	bool result=FALSE;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		if(!g_busy){
+			/* Parallel load pulse samples the 165 inputs */
+			CLEAR_BIT(EXPANDER_LOAD_PORT,EXPANDER_LOAD);
+			SET_BIT(EXPANDER_LOAD_PORT,EXPANDER_LOAD);
+
+			g_busy=TRUE;
+			g_dirty=FALSE;
+			result=SPI_submit(&g_refresh);
+			if(!result){
+				g_busy=FALSE;
+				g_dirty=TRUE;
+			}
+		}
+	}
+	return result;
+}
+
+/********************************************************************************
+ *  [Function Name]:	EXPANDER_startRefresh
+ *  [Description] :		This function is responsible for flushing every
+ *  					EXPANDER_TICK_MS from TIMER2 compare match
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void EXPANDER_startRefresh(void){
+	Timer_ConfigType tick={TIMER2,CMP,NONE1,F2_CPU_1024,NONE_OCO,0,EXPANDER_TICK_COMPARE,0};
+
+	TIMER_setCallBack(TIMER2,EXPANDER_tick);
+	TIMER_init(&tick);
+}
+
+/********************************************************************************
+ *  [Function Name]:	EXPANDER_stopRefresh
+ *  [Description] :		This function is responsible for stopping the timer
+ *  					refresh
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void EXPANDER_stopRefresh(void){
+	TIMER_deinit(TIMER2);
+}
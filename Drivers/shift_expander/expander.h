@@ -0,0 +1,75 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<expander.h>
+ *
+ * [MODULE]:		<EXPANDER>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Header file for the 74HC595/74HC165 shift-register I/O expander>
+ * 					<595 chain on MOSI, 165 chain on MISO, chip select of the
+ * 					 SPI device is the 595 latch (RCLK) and the 165 CLK INH>
+ *
+ *******************************************************************************/
+#ifndef EXPANDER_H_
+#define EXPANDER_H_
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "spi.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Number of chained 595 and 165 */
+#define EXPANDER_OUTPUT_BYTES 2
+#define EXPANDER_INPUT_BYTES  1
+
+/* 165 parallel load pin (SH/LD), active low */
+#define EXPANDER_LOAD_PORT	PORTB
+#define EXPANDER_LOAD_DDR	DDRB
+#define EXPANDER_LOAD		PB1
+
+/* Period of the timer refresh */
+#define EXPANDER_TICK_MS 10
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/* This function is responsible for initializing the expander on a device of the SPI table */
+void EXPANDER_init(uint8 a_device);
+
+/* This function is responsible for setting an output pin in the shadow image */
+void EXPANDER_setPin(uint8 a_pin);
+
+/* This function is responsible for clearing an output pin in the shadow image */
+void EXPANDER_clearPin(uint8 a_pin);
+
+/* This function is responsible for writing a whole output register in the shadow image */
+void EXPANDER_writeByte(uint8 a_index,uint8 a_value);
+
+/* This function is responsible for reading an input pin from the last refresh */
+uint8 EXPANDER_readPin(uint8 a_pin);
+
+/* This function is responsible for reading a whole input register from the last refresh */
+uint8 EXPANDER_readByte(uint8 a_index);
+
+/* This function is responsible for starting one burst that latches outputs and samples inputs */
+bool EXPANDER_flush(void);
+
+/* This function is responsible for flushing every EXPANDER_TICK_MS from TIMER2 */
+void EXPANDER_startRefresh(void);
+
+/* This function is responsible for stopping the timer refresh */
+void EXPANDER_stopRefresh(void);
+
+#endif /* EXPANDER_H_ */
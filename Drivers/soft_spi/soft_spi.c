@@ -0,0 +1,264 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<soft_spi.c>
+ *
+ * [MODULE]:		<SOFT_SPI>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Source file for the bit-banged SPI master>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "soft_spi.h"
+
+#if ((SOFT_SPI_MODE < 0) || (SOFT_SPI_MODE > 3))
+#error "SOFT_SPI_MODE must be 0, 1, 2 or 3"
+#endif
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Leading and trailing clock edges, idle level comes from CPOL */
+#if((SOFT_SPI_MODE & 0x02)==0)
+#define SOFT_SPI_SCK_IDLE()		CLEAR_BIT(SOFT_SPI_PORT,SOFT_SPI_SCK)
+#define SOFT_SPI_SCK_LEAD()		SET_BIT(SOFT_SPI_PORT,SOFT_SPI_SCK)
+#define SOFT_SPI_SCK_TRAIL()	CLEAR_BIT(SOFT_SPI_PORT,SOFT_SPI_SCK)
+#else
+#define SOFT_SPI_SCK_IDLE()		SET_BIT(SOFT_SPI_PORT,SOFT_SPI_SCK)
+#define SOFT_SPI_SCK_LEAD()		CLEAR_BIT(SOFT_SPI_PORT,SOFT_SPI_SCK)
+#define SOFT_SPI_SCK_TRAIL()	SET_BIT(SOFT_SPI_PORT,SOFT_SPI_SCK)
+#endif
+
+/* Mask of the n-th bit on the wire */
+#if(SOFT_SPI_DORD==0)
+#define SOFT_SPI_MASK(n)		(0x80>>(n))
+#else
+#define SOFT_SPI_MASK(n)		(0x01<<(n))
+#endif
+
+#define SOFT_SPI_OUT(data,n) \
+	if((data) & SOFT_SPI_MASK(n)) SET_BIT(SOFT_SPI_PORT,SOFT_SPI_MOSI); \
+	else CLEAR_BIT(SOFT_SPI_PORT,SOFT_SPI_MOSI)
+
+#define SOFT_SPI_IN(received,n) \
+	if(BIT_IS_SET(SOFT_SPI_PIN,SOFT_SPI_MISO)) (received)|=SOFT_SPI_MASK(n)
+
+/* CPHA=0 data is set before the leading edge and sampled on it,
+ * CPHA=1 data is set on the leading edge and sampled on the trailing one */
+#if((SOFT_SPI_MODE & 0x01)==0)
+#define SOFT_SPI_BIT(data,received,n) \
+	do{ \
+		SOFT_SPI_OUT(data,n); \
+		SOFT_SPI_SCK_LEAD(); \
+		SOFT_SPI_IN(received,n); \
+		SOFT_SPI_SCK_TRAIL(); \
+	}while(0)
+#else
+#define SOFT_SPI_BIT(data,received,n) \
+	do{ \
+		SOFT_SPI_SCK_LEAD(); \
+		SOFT_SPI_OUT(data,n); \
+		SOFT_SPI_SCK_TRAIL(); \
+		SOFT_SPI_IN(received,n); \
+	}while(0)
+#endif
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	SOFT_SPI_shift
+ *  [Description] :		This function is responsible for clocking one byte out
+ *  					and in, the eight bits are unrolled so no loop counter
+ *  					or variable shift is left between the edges
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						byte to send
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			The received byte
+ *********************************************************************************/
+static inline uint8 SOFT_SPI_shift(uint8 a_data){
+	uint8 received=0;
+
+	SOFT_SPI_BIT(a_data,received,0);
+	SOFT_SPI_BIT(a_data,received,1);
+	SOFT_SPI_BIT(a_data,received,2);
+	SOFT_SPI_BIT(a_data,received,3);
+	SOFT_SPI_BIT(a_data,received,4);
+	SOFT_SPI_BIT(a_data,received,5);
+	SOFT_SPI_BIT(a_data,received,6);
+	SOFT_SPI_BIT(a_data,received,7);
+	return received;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	SOFT_SPI_init
+ *  [Description] :		This function is responsible for initializing the bus
+ *  					pins, clock at its idle level and chip select high
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SOFT_SPI_init(void){
+	SET_BIT(SOFT_SPI_PORT,SOFT_SPI_CS);
+	SOFT_SPI_SCK_IDLE();
+
+	SET_BIT(SOFT_SPI_DDR,SOFT_SPI_CS);
+	SET_BIT(SOFT_SPI_DDR,SOFT_SPI_SCK);
+	SET_BIT(SOFT_SPI_DDR,SOFT_SPI_MOSI);
+	CLEAR_BIT(SOFT_SPI_DDR,SOFT_SPI_MISO);
+}
+
+/********************************************************************************
+ *  [Function Name]:	SOFT_SPI_select
+ *  [Description] :		This function is responsible for asserting chip select
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SOFT_SPI_select(void){
+	CLEAR_BIT(SOFT_SPI_PORT,SOFT_SPI_CS);
+}
+
+/********************************************************************************
+ *  [Function Name]:	SOFT_SPI_deselect
+ *  [Description] :		This function is responsible for releasing chip select
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SOFT_SPI_deselect(void){
+	SET_BIT(SOFT_SPI_PORT,SOFT_SPI_CS);
+}
+
+/********************************************************************************
+ *  [Function Name]:	SOFT_SPI_sendByte
+ *  [Description] :		This function is responsible for sending one byte
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						contain data that will be sent
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SOFT_SPI_sendByte(const uint8 a_data){
+	SOFT_SPI_shift(a_data);
+}
+
+/********************************************************************************
+ *  [Function Name]:	SOFT_SPI_receiveByte
+ *  [Description] :		This function is responsible for receiving one byte
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			The received data.
+ *********************************************************************************/
+uint8 SOFT_SPI_receiveByte(void){
+	return SOFT_SPI_shift(SOFT_SPI_DUMMY_BYTE);
+}
+
+/********************************************************************************
+ *  [Function Name]:	SOFT_SPI_exchangeByte
+ *  [Description] :		This function is responsible for exchanging one byte
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						contain data that will be sent
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			The received data.
+ *********************************************************************************/
+uint8 SOFT_SPI_exchangeByte(const uint8 a_data){
+	return SOFT_SPI_shift(a_data);
+}
+
+/********************************************************************************
+ *  [Function Name]:	SOFT_SPI_sendString
+ *  [Description] :		This function is responsible for sending String
+ *  [Args] :
+ *  [in]				const uint8 *a_str_Ptr:
+ *  						contain address of data that will be sent
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SOFT_SPI_sendString(const uint8 *a_str_Ptr){
+	while(*a_str_Ptr!='\0'){
+		SOFT_SPI_shift(*a_str_Ptr);
+		a_str_Ptr++;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	SOFT_SPI_writeBurst
+ *  [Description] :		This function is responsible for sending a buffer
+ *  [Args] :
+ *  [in]				const uint8 *a_data_Ptr:
+ *  						bytes to send
+ *  					uint16 a_length:
+ *  						number of bytes
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SOFT_SPI_writeBurst(const uint8 *a_data_Ptr,uint16 a_length){
+	while(a_length--){
+		SOFT_SPI_shift(*a_data_Ptr++);
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	SOFT_SPI_readBurst
+ *  [Description] :		This function is responsible for receiving a buffer
+ *  [Args] :
+ *  [in]				uint16 a_length:
+ *  						number of bytes
+ *  [out]				uint8 *a_data_Ptr:
+ *  						pointer to address that data will be stored at
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SOFT_SPI_readBurst(uint8 *a_data_Ptr,uint16 a_length){
+	while(a_length--){
+		*a_data_Ptr++=SOFT_SPI_shift(SOFT_SPI_DUMMY_BYTE);
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	SOFT_SPI_exchangeBurst
+ *  [Description] :		This function is responsible for exchanging a buffer
+ *  [Args] :
+ *  [in]				const uint8 *a_tx_Ptr:
+ *  						bytes to send
+ *  					uint16 a_length:
+ *  						number of bytes
+ *  [out]				uint8 *a_rx_Ptr:
+ *  						received bytes, can be the same buffer as a_tx_Ptr
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SOFT_SPI_exchangeBurst(const uint8 *a_tx_Ptr,uint8 *a_rx_Ptr,uint16 a_length){
+	while(a_length--){
+		*a_rx_Ptr++=SOFT_SPI_shift(*a_tx_Ptr++);
+	}
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<soft_spi.h>
+ *
+ * [MODULE]:		<SOFT_SPI>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Header file for the bit-banged SPI master>
+ * 					<Pins and mode are constants so every edge can compile to>
+ * 					<one SBI/CBI. The SCK rate has not been measured on a chip>
+ *
+ *******************************************************************************/
+#ifndef SOFT_SPI_H_
+#define SOFT_SPI_H_
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* All bus pins on one port, must be a port SBI/CBI can reach */
+#define SOFT_SPI_PORT		PORTC
+#define SOFT_SPI_DDR		DDRC
+#define SOFT_SPI_PIN		PINC
+
+#define SOFT_SPI_SCK		PC2
+#define SOFT_SPI_MOSI		PC3
+#define SOFT_SPI_MISO		PC4
+#define SOFT_SPI_CS			PC5
+
+/* SPI mode 0..3, CPOL is bit 1 and CPHA is bit 0 */
+#define SOFT_SPI_MODE 0
+
+/* Send MSB first write 0
+ * Send LSB first write 1
+ */
+#define SOFT_SPI_DORD 0
+
+/* Sent by the read functions */
+#define SOFT_SPI_DUMMY_BYTE 0xFF
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/* This function is responsible for initializing the bus pins */
+void SOFT_SPI_init(void);
+
+/* This function is responsible for asserting chip select */
+void SOFT_SPI_select(void);
+
+/* This function is responsible for releasing chip select */
+void SOFT_SPI_deselect(void);
+
+/* This function is responsible for sending one byte */
+void SOFT_SPI_sendByte(const uint8 a_data);
+
+/* This function is responsible for receiving one byte */
+uint8 SOFT_SPI_receiveByte(void);
+
+/* This function is responsible for exchanging one byte */
+uint8 SOFT_SPI_exchangeByte(const uint8 a_data);
+
+/* This function is responsible for sending String */
+void SOFT_SPI_sendString(const uint8 *a_str_Ptr);
+
+/* This function is responsible for sending a buffer */
+void SOFT_SPI_writeBurst(const uint8 *a_data_Ptr,uint16 a_length);
+
+/* This function is responsible for receiving a buffer */
+void SOFT_SPI_readBurst(uint8 *a_data_Ptr,uint16 a_length);
+
+/* This function is responsible for exchanging a buffer */
+void SOFT_SPI_exchangeBurst(const uint8 *a_tx_Ptr,uint8 *a_rx_Ptr,uint16 a_length);
+
+#endif /* SOFT_SPI_H_ */
@@ -299,7 +299,7 @@ void TIMER_init(const Timer_ConfigType *a_config_Ptr) {
 			OCR2 = a_config_Ptr->s_timer_compare_value;
 
 			/* Enable CMP interrupt */
-			SET_BIT(TIMSK, TOIE2);
+			SET_BIT(TIMSK, OCIE2);
 
 			break;
 
@@ -389,3 +389,33 @@ void TIMER_deinit(uint8 a_timerID){
 		break;
 }
 }
+
+/************************************************************************************
+ *  [Function Name]:	TIMER_restart
+ *  [Description] :		This function is responsible for restarting the count of
+ *  					a running timer from zero and clearing its pending flags,
+ *  					used to measure time since the last event
+ *  [Args] :
+ *  [in]				uint8 a_timerID:
+ *  						Contains Timer Id which will be restarted
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *************************************************************************************/
+void TIMER_restart(uint8 a_timerID){
+	/* Choose between timers, TIFR flags are cleared by writing one */
+	switch (a_timerID) {
+
+	case TIMER0:
+		TCNT0 = 0;	TIFR = (1<<OCF0)|(1<<TOV0);
+		break;
+
+	case TIMER1:
+		TCNT1 = 0;	TIFR = (1<<OCF1A)|(1<<OCF1B)|(1<<TOV1);
+		break;
+
+	case TIMER2:
+		TCNT2 = 0;	TIFR = (1<<OCF2)|(1<<TOV2);
+		break;
+	}
+}
@@ -81,5 +81,7 @@ void TIMER_init(const Timer_ConfigType * a_config_Ptr);
 /*This function is responsible for setting the Call Back function address */
 void TIMER_setCallBack(uint8 a_timerID,void(*a_ptr)(void));
 void TIMER_deinit(uint8 a_timerID);
+/*This function is responsible for restarting the count from zero without reconfiguring */
+void TIMER_restart(uint8 a_timerID);
 
 #endif /* TIMER_H_ */
@@ -41,10 +41,25 @@ typedef enum
 	NO_PARITY,ODD_PARITY,EVEN_PARITY
 }UART_Parity;
 
+/* W9_BITS uses UCSZ1:0 in UCSRC plus UCSZ2 in UCSRB */
 typedef enum
 {
-	W5_BITS,W6_BITS=2,W7_BITS=4,W8_BITS=6
+	W5_BITS,W6_BITS=2,W7_BITS=4,W8_BITS=6,W9_BITS=7
 }UART_WORD_BITS;
+
+/* What UART_write does when the transmit buffer has no room for the data */
+typedef enum
+{
+	TX_BLOCK,TX_DROP,TX_SHORT_COUNT
+}UART_TxPolicy;
+
+/* Flow control used to pause the other side and to be paused by it */
+typedef enum
+{
+	NO_FLOW_CONTROL,XON_XOFF,RTS_CTS
+}UART_FlowControl;
+
+/* s_rate is kept for old configurations, U2X is now chosen from the baud rate */
 typedef struct
 {
 	UART_Rate 	s_rate;
@@ -54,13 +69,139 @@ typedef struct
 	uint32		s_baudRate;
 	uint8		s_safeChar;
 	UART_WORD_BITS s_word_bits;
+	UART_TxPolicy s_tx_policy;
+	bool		s_mpcm;			/* Multi-processor mode, needs W9_BITS */
+	uint8		s_address;		/* Node address used when s_mpcm is TRUE */
+	UART_FlowControl s_flow_control;	/* Needs s_rx_mode INTTERRUPT */
 
 }UART_ConfigType;
 
+/* Result of UART_autoBaud */
+typedef struct
+{
+	uint32 s_measured_rate;	/* Rate measured from the sync character */
+	uint32 s_baudRate;		/* Standard rate chosen and given to UART_init */
+	uint16 s_error;			/* UBRR error of s_baudRate in per-mille */
+}UART_AutoBaudType;
+
+/* Result of UART_receiveBlock */
+typedef struct
+{
+	uint8  s_errors;		/* UART_RX_ERROR_MASK and UART_RX_OVERFLOW flags of all bytes ORed */
+	uint16 s_first_error;	/* Index of first byte with a flag, block length if none */
+}UART_BlockStatusType;
+
+/* Receive error counters collected by USART_RXC_vect */
+typedef struct
+{
+	uint16 s_frame_errors;
+	uint16 s_data_overruns;
+	uint16 s_parity_errors;
+	uint16 s_buffer_overflows;
+}UART_ErrorCountersType;
+
 /*******************************************************************************
  *                      Preprocessor Macros                                    *
  *******************************************************************************/
 
+/* Baud rate used by the application, UART_init uses the values below
+ * without any division when s_baudRate equals this rate */
+#ifndef UART_BAUD_RATE
+#define UART_BAUD_RATE 9600UL
+#endif
+
+/* Highest accepted baud rate error in per-mille (20 ----> 2%) */
+#ifndef UART_BAUD_TOLERANCE
+#define UART_BAUD_TOLERANCE 20UL
+#endif
+
+/* UBRR rounded to nearest for divider 16 (normal) or 8 (double speed) */
+#define UART_UBRR_CALC(BAUD,DIV)	((((F_CPU)+((DIV)/2UL)*(BAUD))/((DIV)*(BAUD)))-1UL)
+
+/* Real baud rate given by UART_UBRR_CALC */
+#define UART_BAUD_REAL(BAUD,DIV)	((F_CPU)/((DIV)*(UART_UBRR_CALC(BAUD,DIV)+1UL)))
+
+/* Baud rate error in per-mille */
+#define UART_BAUD_ERROR(BAUD,DIV)	\
+	(((UART_BAUD_REAL(BAUD,DIV)>(BAUD))?(UART_BAUD_REAL(BAUD,DIV)-(BAUD)):((BAUD)-UART_BAUD_REAL(BAUD,DIV)))*1000UL/(BAUD))
+
+/* Divider 16 is only usable when its UBRR is in range */
+#define UART_NORMAL_VALID(BAUD)		(((F_CPU)+8UL*(BAUD))/(16UL*(BAUD))>=1UL && UART_UBRR_CALC(BAUD,16UL)<=4095UL)
+
+/* Pick double speed whenever it gives a smaller error */
+#define UART_USE_U2X(BAUD)			(!UART_NORMAL_VALID(BAUD) || UART_BAUD_ERROR(BAUD,8UL)<UART_BAUD_ERROR(BAUD,16UL))
+
+/* Values calculated at compile time for UART_BAUD_RATE */
+#if UART_USE_U2X(UART_BAUD_RATE)
+#define UART_U2X_VALUE		1
+#define UART_UBRR_VALUE		UART_UBRR_CALC(UART_BAUD_RATE,8UL)
+#define UART_BAUD_ERROR_VALUE	UART_BAUD_ERROR(UART_BAUD_RATE,8UL)
+#else
+#define UART_U2X_VALUE		0
+#define UART_UBRR_VALUE		UART_UBRR_CALC(UART_BAUD_RATE,16UL)
+#define UART_BAUD_ERROR_VALUE	UART_BAUD_ERROR(UART_BAUD_RATE,16UL)
+#endif
+
+#define UART_UBRRH_VALUE	((uint8)(UART_UBRR_VALUE>>8))
+#define UART_UBRRL_VALUE	((uint8)(UART_UBRR_VALUE & 0xFF))
+
+#if ((F_CPU)+4UL*(UART_BAUD_RATE))/(8UL*(UART_BAUD_RATE))<1UL || UART_UBRR_VALUE>4095UL
+#error "UART_BAUD_RATE can not be generated from F_CPU"
+#elif UART_BAUD_ERROR_VALUE>UART_BAUD_TOLERANCE
+#error "UART_BAUD_RATE error is above UART_BAUD_TOLERANCE for this F_CPU"
+#endif
+
+/* Receive buffer fill levels that stop and restart the other side */
+#define UART_RX_HIGH_WATER	((UART_RX_BUFFER_SIZE*3)/4)
+#define UART_RX_LOW_WATER	(UART_RX_BUFFER_SIZE/4)
+
+/* Software flow control characters */
+#define UART_XON	0x11
+#define UART_XOFF	0x13
+
+/* RTS output, low while we can take more data */
+#define UART_RTS_PORT	PORTD
+#define UART_RTS_DIR	DDRD
+#define UART_RTS_PIN	PD7
+
+/* CTS input, low while the other side can take more data
+ * PD3 is INT1 so UART_ctsChanged can be its external interrupt call back */
+#define UART_CTS_IN		PIND
+#define UART_CTS_PORT	PORTD
+#define UART_CTS_DIR	DDRD
+#define UART_CTS_PIN	PD3
+
+/* To use UART_autoBaud write 1, it needs RXD (PD0) wired to ICP1 (PD6)
+ * and uses TIMER1 while measuring */
+#ifndef UART_AUTOBAUD
+#define UART_AUTOBAUD 0
+#endif
+
+/* Character the host sends for auto-baud, 0x55 gives an edge every bit */
+#define UART_AUTOBAUD_SYNC 0x55
+
+/* Measured rate is replaced by a standard rate when this close (per-mille) */
+#define UART_AUTOBAUD_SNAP 30UL
+
+/* UCSRA error flags given with each received byte */
+#define UART_RX_ERROR_MASK	((1<<FE)|(1<<DOR)|(1<<PE))
+
+/* Status flag kept with a buffered byte when bytes before it were lost
+ * because the receive buffer was full */
+#define UART_RX_OVERFLOW	(1<<U2X)
+
+/* Status flag given with bytes whose 9th bit (RXB8) is set in W9_BITS mode,
+ * by UART_receiveByteStatus and to the receive handler */
+#define UART_RX_BIT9		(1<<MPCM)
+
+/* Size of the transmit ring buffer drained by USART_UDRE_vect
+ * must be a power of two between 2 and 256 */
+#define UART_TX_BUFFER_SIZE 64
+
+/* Size of the receive ring buffer filled by USART_RXC_vect
+ * must be a power of two between 2 and 256 */
+#define UART_RX_BUFFER_SIZE 64
+
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
@@ -74,13 +215,60 @@ void UART_sendByte(uint8 a_data);
 /* This function is responsible for receiving one byte */
 uint8 UART_receiveByte(void);
 
+/* This function is responsible for receiving one byte with its status flags and 9th bit */
+uint8 UART_receiveByteStatus(uint8 *a_status_Ptr);
+
 /* This function is responsible for sending String */
 void UART_sendString(uint8 *a_str);
 
 /* This function is responsible for receiving String */
 void UART_receiveString(uint8 *a_str);
 
+/* This function is responsible for queuing bytes for interrupt driven sending */
+uint16 UART_write(const uint8 *a_data_Ptr,uint16 a_length);
+
+/* This function is responsible for queuing String for interrupt driven sending */
+uint16 UART_writeString(const uint8 *a_str_Ptr);
+
+/* This function is responsible for returning the highest transmit buffer fill level */
+uint8 UART_getTxHighWaterMark(void);
+
+/* This function is responsible for returning number of bytes dropped by UART_write */
+uint16 UART_getTxDropCount(void);
+
+/* This function is responsible for returning number of received bytes waiting */
+uint8 UART_available(void);
+
+/* This function is responsible for taking bytes out of the receive buffer */
+uint8 UART_read(uint8 *a_data_Ptr,uint8 a_length);
+
+/* This function is responsible for looking at next received byte without removing it */
+bool UART_peek(uint8 *a_data_Ptr);
+
+/* This function is responsible for receiving a block with the error status of its bytes */
+void UART_receiveBlock(uint8 *a_data_Ptr,uint16 a_length,UART_BlockStatusType *a_status_Ptr);
+
+/* This function is responsible for copying the receive error counters */
+void UART_getErrorCounters(UART_ErrorCountersType *a_counters_Ptr);
+
+/* This function is responsible for sending an address frame in multi-processor mode */
+void UART_sendAddress(uint8 a_address);
+
+#if (UART_AUTOBAUD==1)
+/* This function is responsible for measuring the host baud rate then initializing the UART */
+bool UART_autoBaud(UART_ConfigType *a_config_Ptr,uint16 a_timeout_ms,UART_AutoBaudType *a_result_Ptr);
+#endif
+
+/* This function is responsible for restarting transmission after CTS changed */
+void UART_ctsChanged(void);
+
+/* This function is responsible for returning number of bytes still waiting to be sent */
+uint8 UART_txPending(void);
+
 /*This function is responsible for saving the address that will be called after interrupts happen */
 void UART_callBackAdress(void(*a_Func_Ptr)(void),uint8 TorR);
 
+/* This function is responsible for giving received bytes to an upper layer from the ISR */
+void UART_setReceiveHandler(void(*a_handler_Ptr)(uint8 a_data,uint8 a_status));
+
 #endif
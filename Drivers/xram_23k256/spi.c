@@ -0,0 +1,796 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<spi.c>
+ *
+ * [MODULE]:		<SPI>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<11/11/2020>
+ *
+ * [DESCRIPTION]:	<Source file for the SPI driver>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "spi.h"
+
+/* For sharing the transaction queue with the ISRs */
+#include <util/atomic.h>
+
+#if ((SPI_QUEUE_SIZE < 1) || (SPI_QUEUE_SIZE > 254))
+#error "SPI_QUEUE_SIZE must be between 1 and 254"
+#endif
+
+#if (SPI_QUEUE_PRIORITIES < 1)
+#error "SPI_QUEUE_PRIORITIES must be at least 1"
+#endif
+
+/* End of a queue list */
+#define SPI_QUEUE_NONE 0xFF
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+/* Global variable used for call back technique */
+
+#if(SPI_INTENABLE==1)
+static void(*g_SPI_interrupt_Func_Ptr)(void)=NULL_PTR;
+#endif
+
+/* SPCR/SPSR of every device, computed once by SPI_initDevices */
+typedef struct
+{
+	uint8 s_spcr;
+	uint8 s_spsr;
+	volatile uint8 *s_cs_port_Ptr;
+	uint8 s_cs_mask;
+}SPI_DeviceType;
+
+static SPI_DeviceType g_devices[SPI_MAX_DEVICES];
+static uint8 g_device_count=0;
+
+/* Device the bus registers are set for */
+static uint8 g_current_device=SPI_NO_DEVICE;
+
+/* State of SPI_transfer, moved forward one byte per SPI_STC_vect */
+static const uint8 *g_tx_Ptr=NULL_PTR;
+static uint8 *g_rx_Ptr=NULL_PTR;
+static volatile uint16 g_transfer_length=0;
+static volatile uint16 g_transfer_index=0;
+static volatile bool g_transfer_busy=FALSE;
+static void(*volatile g_done_callBack_Ptr)(void)=NULL_PTR;
+
+/* State of the slave register map responder */
+typedef enum
+{
+	SLAVE_ADDRESS,SLAVE_READ,SLAVE_WRITE
+}SPI_SlaveState;
+
+static const SPI_SlaveMapType *g_slave_map_Ptr=NULL_PTR;
+static volatile SPI_SlaveState g_slave_state=SLAVE_ADDRESS;
+static volatile uint8 g_slave_register=0;
+
+/* Transaction pool, free slots and every priority level are linked lists */
+typedef struct
+{
+	SPI_TransactionType s_transaction;
+	uint8 s_next;
+}SPI_QueueSlotType;
+
+static SPI_QueueSlotType g_queue[SPI_QUEUE_SIZE];
+static uint8 g_queue_free=SPI_QUEUE_NONE;
+static uint8 g_queue_head[SPI_QUEUE_PRIORITIES];
+static uint8 g_queue_tail[SPI_QUEUE_PRIORITIES];
+static volatile uint8 g_queue_active=SPI_QUEUE_NONE;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	SPI_slaveRespond
+ *  [Description] :		This function is responsible for handling one byte of
+ *  					the register map and preloading SPDR with the byte the
+ *  					master clocks out next, runs inside SPI_STC_vect, past
+ *  					the map writes are ignored and reads give SPI_DUMMY_BYTE
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static inline void SPI_slaveRespond(void){
+	const SPI_SlaveMapType *map_Ptr=g_slave_map_Ptr;
+	uint8 data=SPDR;
+	uint8 reg=g_slave_register;
+	uint8 mask;
+
+	if(g_slave_state==SLAVE_ADDRESS){
+		reg=data & (~SPI_SLAVE_WRITE);
+		g_slave_state=(data & SPI_SLAVE_WRITE) ? SLAVE_WRITE : SLAVE_READ;
+	}
+	else{
+		if(g_slave_state==SLAVE_WRITE && reg<map_Ptr->s_count){
+			mask=(map_Ptr->s_read_only_Ptr!=NULL_PTR) ? map_Ptr->s_read_only_Ptr[reg] : 0;
+			map_Ptr->s_registers_Ptr[reg]=(map_Ptr->s_registers_Ptr[reg] & mask) | (data & (~mask));
+		}
+		/* The pointer stops at the end and never wraps into the first registers */
+		if(map_Ptr->s_auto_increment && reg<map_Ptr->s_count){
+			reg++;
+		}
+	}
+	g_slave_register=reg;
+
+	/* Must be in SPDR before the master starts the next byte */
+	SPDR=(reg<map_Ptr->s_count) ? map_Ptr->s_registers_Ptr[reg] : SPI_DUMMY_BYTE;
+}
+
+static void SPI_queueStart(void);
+
+/********************************************************************************
+ *  [Function Name]:	SPI_queueDone
+ *  [Description] :		This function is responsible for ending the running
+ *  					transaction and starting the next one, SPI_transfer
+ *  					call back of queued transactions
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void SPI_queueDone(void){
+	uint8 slot=g_queue_active;
+	void(*callBack_Ptr)(void)=g_queue[slot].s_transaction.s_done_callBack_Ptr;
+
+	SPI_deselect();
+
+	/* Slot is free before the call back so it can submit again */
+	g_queue[slot].s_next=g_queue_free;
+	g_queue_free=slot;
+	g_queue_active=SPI_QUEUE_NONE;
+
+	if(callBack_Ptr!=NULL_PTR){
+		(*callBack_Ptr)();
+	}
+	SPI_queueStart();
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_queueStart
+ *  [Description] :		This function is responsible for starting the first
+ *  					transaction of the highest priority level when the bus
+ *  					is idle, called with interrupts disabled
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void SPI_queueStart(void){
+	SPI_TransactionType *transaction_Ptr;
+	uint8 priority;
+	uint8 slot;
+
+	if(g_queue_active!=SPI_QUEUE_NONE || g_transfer_busy){
+		return;
+	}
+	for(priority=0;priority<SPI_QUEUE_PRIORITIES;priority++){
+		if(g_queue_head[priority]!=SPI_QUEUE_NONE){
+			break;
+		}
+	}
+	if(priority==SPI_QUEUE_PRIORITIES){
+		return;
+	}
+
+	slot=g_queue_head[priority];
+	g_queue_head[priority]=g_queue[slot].s_next;
+	if(g_queue_head[priority]==SPI_QUEUE_NONE){
+		g_queue_tail[priority]=SPI_QUEUE_NONE;
+	}
+	g_queue_active=slot;
+
+	transaction_Ptr=&g_queue[slot].s_transaction;
+	SPI_select(transaction_Ptr->s_device);
+	SPI_transfer(transaction_Ptr->s_tx_Ptr,transaction_Ptr->s_rx_Ptr,transaction_Ptr->s_length,SPI_queueDone);
+}
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+/* ISR activated after data is transmitted */
+ISR(SPI_STC_vect){
+	uint16 index;
+
+	if(g_transfer_busy){
+		index=g_transfer_index;
+		if(g_rx_Ptr!=NULL_PTR){
+			g_rx_Ptr[index]=SPDR;
+		}
+		index++;
+		g_transfer_index=index;
+		if(index<g_transfer_length){
+			/* Next byte goes out right away, the bus idles only for the ISR entry */
+			SPDR=(g_tx_Ptr!=NULL_PTR) ? g_tx_Ptr[index] : SPI_DUMMY_BYTE;
+		}
+		else{
+			g_transfer_busy=FALSE;
+#if(SPI_INTENABLE==0)
+			CLEAR_BIT(SPCR,SPIE);
+#endif
+			if(g_done_callBack_Ptr!=NULL_PTR){
+				(*g_done_callBack_Ptr)();
+			}
+		}
+	}
+	else if(g_slave_map_Ptr!=NULL_PTR){
+		SPI_slaveRespond();
+	}
+#if(SPI_INTENABLE==1)
+	else if(g_SPI_interrupt_Func_Ptr!=NULL_PTR){
+		/* Call the function in the Scheduler using Call Back concept */
+		(*g_SPI_interrupt_Func_Ptr)();
+	}
+#endif
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*************************************************************************************
+ *  [Function Name]:	SPI_initMaster
+ *  [Description] :		This function is responsible for initializing the SPI's Master
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ **************************************************************************************/
+
+void SPI_initMaster(void){
+	/******** Configure SPI Master Pins *********
+	 * SS(PB4)   --> Output
+	 * MOSI(PB5) --> Output
+	 * MISO(PB6) --> Input
+	 * SCK(PB7) --> Output
+	 ********************************************/
+	DDRB |= (1<<PB4);
+	DDRB |= (1<<PB5);
+	DDRB &= ~(1<<PB6);
+	DDRB |= (1<<PB7);
+
+	/* SPE 	set 1 to enable SPI
+	 * MSTR set 1 to make it Master */
+	SPCR=(1<<SPE) | (1<<MSTR);
+
+#if(SPI_INTENABLE==1)
+	/* SPI work with Interrupt */
+	SET_BIT(SPCR,SPIE);
+#endif
+
+#if(SPI_DORD==1)
+	/* Send LSB first */
+	SET_BIT(SPCR,DORD);
+#endif
+
+#if(SPI_CLKPOL==1)
+	/* CLOCK POLARITY with falling edge */
+	SET_BIT(SPCR,CPOL);
+#endif
+
+#if(SPI_DOUPLESPEED==1)
+	/* Make SPI2X=1 to get double speed */
+	SET_BIT(SPSR,SPI2X);
+#endif
+
+	/* Set SPI clk rate */
+	SPCR=(SPCR & 0xFC) | (SPI_CLKRATE & 0x03);
+
+	/* Bus no longer matches any device */
+	g_current_device=SPI_NO_DEVICE;
+}
+
+/*************************************************************************************
+ *  [Function Name]:	SPI_initSlave
+ *  [Description] :		This function is responsible for initializing the SPI's Slave
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ **************************************************************************************/
+
+void SPI_initSlave(void){
+	/******** Configure SPI Slave Pins *********
+	 * SS(PB4)   --> Input
+	 * MOSI(PB5) --> Input
+	 * MISO(PB6) --> Output
+	 * SCK(PB7) --> Input
+	 ********************************************/
+	DDRB &= (~(1<<PB4));
+	DDRB &= (~(1<<PB5));
+	DDRB |= (1<<PB6);
+	DDRB &= (~(1<<PB7));
+
+	/* SPE 	set 1 to enable SPI
+	 * MSTR set 0 to make it Slave */
+	SPCR=(1<<SPE);
+
+#if(SPI_INTENABLE==1)
+	/* SPI work with Interrupt */
+	SET_BIT(SPCR,SPIE);
+#endif
+
+#if(SPI_DORD==1)
+	/* Send LSB first */
+	SET_BIT(SPCR,DORD);
+#endif
+
+#if(SPI_CLKPOL==1)
+	/* CLOCK POLARITY with falling edge */
+	SET_BIT(SPCR,CPOL);
+#endif
+
+#if(SPI_DOUPLESPEED==1)
+	/* Make SPI2X=1 to get double speed */
+	SET_BIT(SPSR,SPI2X);
+#endif
+
+	/* Set SPI clk rate */
+	SPCR=(SPCR & 0xFC) | (SPI_CLKRATE & 0x03);
+
+	/* Bus no longer matches any device */
+	g_current_device=SPI_NO_DEVICE;
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_initSlaveMap
+ *  [Description] :		This function is responsible for initializing the slave
+ *  					to serve a register map from SPI_STC_vect, the reply of
+ *  					every byte is preloaded in the same interrupt so the
+ *  					master only needs a short gap between bytes
+ *  [Args] :
+ *  [in]				const SPI_SlaveMapType *a_map_Ptr:
+ *  						register map, must stay valid while the slave runs
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SPI_initSlaveMap(const SPI_SlaveMapType *a_map_Ptr){
+	SPI_initSlave();
+
+	g_slave_map_Ptr=a_map_Ptr;
+	g_slave_state=SLAVE_ADDRESS;
+	g_slave_register=0;
+
+	SPDR=SPI_DUMMY_BYTE;
+	SET_BIT(SPCR,SPIE);
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_slaveFrameEnd
+ *  [Description] :		This function is responsible for starting a new slave
+ *  					frame so the next byte is taken as an address, call it
+ *  					when SS goes high (e.g. SS also wired to INT2)
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SPI_slaveFrameEnd(void){
+	g_slave_state=SLAVE_ADDRESS;
+	SPDR=SPI_DUMMY_BYTE;
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_sendByte
+ *  [Description] :		This function is responsible for sending one byte
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						contain data that will be sent
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+
+void SPI_sendByte(uint8 a_data){
+	/* Transmit data */
+	SPDR=a_data;
+	/* Wait until current transmission is done */
+	while(BIT_IS_CLEAR(SPSR,SPIF));
+}
+
+#if(SPI_INTENABLE==0)
+/********************************************************************************
+ *  [Function Name]:	SPI_receiveByte
+ *  [Description] :		This function is responsible for receiving one byte
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			The received data.
+ *********************************************************************************/
+uint8 SPI_receiveByte(void){
+	/* Wait until current receiving is finished */
+	while(BIT_IS_CLEAR(SPSR,SPIF));
+	/* Read received data */
+	return SPDR;
+}
+#endif
+
+/********************************************************************************
+ *  [Function Name]:	SPI_sendString
+ *  [Description] :		This function is responsible for sending String
+ *  [Args] :
+ *  [in]				const uint8 *a_str_Ptr:
+ *  						contain address of data that will be sent
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+
+void SPI_sendString(const uint8 *a_str_Ptr){
+	while(*a_str_Ptr!='\0'){
+		SPI_sendByte(*a_str_Ptr);
+		a_str_Ptr++;
+	}
+}
+
+#if(SPI_INTENABLE==0)
+/********************************************************************************
+ *  [Function Name]:	SPI_receiveString
+ *  [Description] :		This function is responsible for receiving String
+ *  [Args] :
+ *  [in]				uint8 *a_str_Ptr:
+ *  						pointer to address that data will be stored at
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None.
+ *********************************************************************************/
+
+void SPI_receiveString(uint8 *a_str_Ptr){
+	uint8 numberofchars;
+	numberofchars=SPI_receiveByte();
+	for(;numberofchars>0;numberofchars--){
+		*a_str_Ptr=SPI_receiveByte();
+		a_str_Ptr++;
+	}
+	*a_str_Ptr='\0';
+}
+#endif
+
+/********************************************************************************
+ *  [Function Name]:	SPI_writeBurst
+ *  [Description] :		This function is responsible for sending a buffer with
+ *  					no idle time between bytes, next byte is fetched while
+ *  					the current one shifts and written as soon as SPIF sets
+ *  [Args] :
+ *  [in]				const uint8 *a_data_Ptr:
+ *  						bytes to send
+ *  					uint16 a_length:
+ *  						number of bytes
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SPI_writeBurst(const uint8 *a_data_Ptr,uint16 a_length){
+	uint8 next;
+
+	if(a_length==0){
+		return;
+	}
+	SPDR=*a_data_Ptr++;
+	while(--a_length){
+		next=*a_data_Ptr++;
+		while(BIT_IS_CLEAR(SPSR,SPIF));
+		/* Writing SPDR also clears SPIF */
+		SPDR=next;
+	}
+	while(BIT_IS_CLEAR(SPSR,SPIF));
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_readBurst
+ *  [Description] :		This function is responsible for receiving a buffer with
+ *  					no idle time between bytes, next SPI_DUMMY_BYTE is sent
+ *  					right after SPDR is read and the store is done while it
+ *  					shifts
+ *  [Args] :
+ *  [in]				uint16 a_length:
+ *  						number of bytes
+ *  [out]				uint8 *a_data_Ptr:
+ *  						pointer to address that data will be stored at
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SPI_readBurst(uint8 *a_data_Ptr,uint16 a_length){
+	uint8 data;
+
+	if(a_length==0){
+		return;
+	}
+	SPDR=SPI_DUMMY_BYTE;
+	while(--a_length){
+		while(BIT_IS_CLEAR(SPSR,SPIF));
+		data=SPDR;
+		SPDR=SPI_DUMMY_BYTE;
+		*a_data_Ptr++=data;
+	}
+	while(BIT_IS_CLEAR(SPSR,SPIF));
+	*a_data_Ptr=SPDR;
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_exchangeBurst
+ *  [Description] :		This function is responsible for exchanging a buffer with
+ *  					no idle time between bytes, next byte to send is fetched
+ *  					while the current one shifts
+ *  [Args] :
+ *  [in]				const uint8 *a_tx_Ptr:
+ *  						bytes to send
+ *  					uint16 a_length:
+ *  						number of bytes
+ *  [out]				uint8 *a_rx_Ptr:
+ *  						received bytes, can be the same buffer as a_tx_Ptr
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SPI_exchangeBurst(const uint8 *a_tx_Ptr,uint8 *a_rx_Ptr,uint16 a_length){
+	uint8 next;
+	uint8 data;
+
+	if(a_length==0){
+		return;
+	}
+	SPDR=*a_tx_Ptr++;
+	while(--a_length){
+		next=*a_tx_Ptr++;
+		while(BIT_IS_CLEAR(SPSR,SPIF));
+		data=SPDR;
+		SPDR=next;
+		*a_rx_Ptr++=data;
+	}
+	while(BIT_IS_CLEAR(SPSR,SPIF));
+	*a_rx_Ptr=SPDR;
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_initDevices
+ *  [Description] :		This function is responsible for precomputing SPCR/SPSR of
+ *  					every device on the bus and driving their chip selects high,
+ *  					call SPI_initMaster first for the bus pins
+ *  [Args] :
+ *  [in]				const SPI_DeviceConfigType *a_devices_Ptr:
+ *  						table of devices, index in it is the device number
+ *  					uint8 a_count:
+ *  						number of devices, up to SPI_MAX_DEVICES
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SPI_initDevices(const SPI_DeviceConfigType *a_devices_Ptr,uint8 a_count){
+	uint8 i;
+
+	if(a_count>SPI_MAX_DEVICES){
+		a_count=SPI_MAX_DEVICES;
+	}
+
+	for(i=0;i<a_count;i++){
+		g_devices[i].s_spcr=(1<<SPE) | (1<<MSTR) | a_devices_Ptr[i].s_mode |
+				a_devices_Ptr[i].s_bit_order | (a_devices_Ptr[i].s_clock & 0x03);
+#if(SPI_INTENABLE==1)
+		g_devices[i].s_spcr|=(1<<SPIE);
+#endif
+		g_devices[i].s_spsr=((a_devices_Ptr[i].s_clock>>2) & 0x01)<<SPI2X;
+		g_devices[i].s_cs_port_Ptr=a_devices_Ptr[i].s_cs_port_Ptr;
+		g_devices[i].s_cs_mask=(1<<a_devices_Ptr[i].s_cs_pin);
+
+		/* Chip select high then output, DDRx is one address below PORTx */
+		*(g_devices[i].s_cs_port_Ptr)|=g_devices[i].s_cs_mask;
+		*(g_devices[i].s_cs_port_Ptr-1)|=g_devices[i].s_cs_mask;
+	}
+	g_device_count=a_count;
+	g_current_device=SPI_NO_DEVICE;
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_select
+ *  [Description] :		This function is responsible for setting the bus for a
+ *  					device and asserting its chip select, registers are
+ *  					written only when the bus was set for another device
+ *  [Args] :
+ *  [in]				uint8 a_device:
+ *  						index of device in the table given to SPI_initDevices
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SPI_select(uint8 a_device){
+	if(a_device>=g_device_count){
+		return;
+	}
+	if(a_device!=g_current_device){
+		SPCR=g_devices[a_device].s_spcr;
+		SPSR=g_devices[a_device].s_spsr;
+		g_current_device=a_device;
+	}
+	*(g_devices[a_device].s_cs_port_Ptr)&=~g_devices[a_device].s_cs_mask;
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_deselect
+ *  [Description] :		This function is responsible for releasing chip select
+ *  					of the selected device, bus registers are kept so the
+ *  					next SPI_select of the same device writes nothing
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SPI_deselect(void){
+	if(g_current_device!=SPI_NO_DEVICE){
+		*(g_devices[g_current_device].s_cs_port_Ptr)|=g_devices[g_current_device].s_cs_mask;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_transfer
+ *  [Description] :		This function is responsible for starting an interrupt
+ *  					driven full-duplex transfer, SPI_STC_vect clocks out the
+ *  					next byte and stores the received one, select the device
+ *  					before calling it and deselect it in the call back
+ *  [Args] :
+ *  [in]				const uint8 *a_tx_Ptr:
+ *  						bytes to send, NULL_PTR sends SPI_DUMMY_BYTE
+ *  					uint16 a_length:
+ *  						number of bytes to exchange
+ *  					void(*a_done_callBack_Ptr)(void):
+ *  						called from the ISR after the last byte, can be NULL_PTR
+ *  [out]				uint8 *a_rx_Ptr:
+ *  						received bytes, NULL_PTR drops them
+ *  [in/out]			None
+ *  [Returns]			FALSE when a transfer is already running
+ *********************************************************************************/
+bool SPI_transfer(const uint8 *a_tx_Ptr,uint8 *a_rx_Ptr,uint16 a_length,void(*a_done_callBack_Ptr)(void)){
+	if(g_transfer_busy){
+		return FALSE;
+	}
+	if(a_length==0){
+		if(a_done_callBack_Ptr!=NULL_PTR){
+			(*a_done_callBack_Ptr)();
+		}
+		return TRUE;
+	}
+
+	g_tx_Ptr=a_tx_Ptr;
+	g_rx_Ptr=a_rx_Ptr;
+	g_transfer_length=a_length;
+	g_transfer_index=0;
+	g_done_callBack_Ptr=a_done_callBack_Ptr;
+	g_transfer_busy=TRUE;
+
+	/* Reading SPSR then SPDR clears a SPIF left by a polled call, so the
+	 * interrupt fires only once the first byte below has shifted out */
+	(void)SPSR;
+	(void)SPDR;
+	SPDR=(a_tx_Ptr!=NULL_PTR) ? a_tx_Ptr[0] : SPI_DUMMY_BYTE;
+	SET_BIT(SPCR,SPIE);
+	return TRUE;
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_isBusy
+ *  [Description] :		This function is responsible for telling if SPI_transfer
+ *  					is still running
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			TRUE while bytes are left to exchange
+ *********************************************************************************/
+bool SPI_isBusy(void){
+	return g_transfer_busy;
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_initQueue
+ *  [Description] :		This function is responsible for emptying the transaction
+ *  					queue, call it after SPI_initDevices
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void SPI_initQueue(void){
+	uint8 i;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		for(i=0;i<SPI_QUEUE_SIZE;i++){
+			g_queue[i].s_next=i+1;
+		}
+		g_queue[SPI_QUEUE_SIZE-1].s_next=SPI_QUEUE_NONE;
+		g_queue_free=0;
+		for(i=0;i<SPI_QUEUE_PRIORITIES;i++){
+			g_queue_head[i]=SPI_QUEUE_NONE;
+			g_queue_tail[i]=SPI_QUEUE_NONE;
+		}
+		g_queue_active=SPI_QUEUE_NONE;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	SPI_submit
+ *  [Description] :		This function is responsible for copying a transaction
+ *  					into the queue, transactions run back to back from
+ *  					SPI_STC_vect with chip select handled for them, safe to
+ *  					call from other ISRs, do not mix with direct SPI_transfer
+ *  [Args] :
+ *  [in]				const SPI_TransactionType *a_transaction_Ptr:
+ *  						transaction, its buffers must stay valid until its call back
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			FALSE when the queue is full or the transaction is invalid
+ *********************************************************************************/
+bool SPI_submit(const SPI_TransactionType *a_transaction_Ptr){
+	uint8 priority=a_transaction_Ptr->s_priority;
+	uint8 slot;
+	bool result=FALSE;
+
+	if(a_transaction_Ptr->s_length==0 || a_transaction_Ptr->s_device>=g_device_count){
+		return FALSE;
+	}
+	if(priority>=SPI_QUEUE_PRIORITIES){
+		priority=SPI_QUEUE_PRIORITIES-1;
+	}
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		slot=g_queue_free;
+		if(slot!=SPI_QUEUE_NONE){
+			g_queue_free=g_queue[slot].s_next;
+			g_queue[slot].s_transaction=*a_transaction_Ptr;
+			g_queue[slot].s_next=SPI_QUEUE_NONE;
+
+			/* Append at tail of its level */
+			if(g_queue_tail[priority]==SPI_QUEUE_NONE){
+				g_queue_head[priority]=slot;
+			}
+			else{
+				g_queue[g_queue_tail[priority]].s_next=slot;
+			}
+			g_queue_tail[priority]=slot;
+
+			SPI_queueStart();
+			result=TRUE;
+		}
+	}
+	return result;
+}
+
+#if(SPI_INTENABLE==1)
+/**********************************************************************************************
+ *  [Function Name]:	SPI_callBackAdress
+ *  [Description] :		This function is responsible for saving the address that
+ *  					will be called after interrupts happen
+ *  [Args] :
+ *  [in]				void(*a_Func_Ptr)(void):
+ *  						Pointer to function used to store function's address ISR will call
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			The received data.
+ ***********************************************************************************************/
+void SPI_callBackAdress(void(*a_Func_Ptr)(void)){
+		g_SPI_interrupt_Func_Ptr=a_Func_Ptr;
+}
+#endif
+
+
@@ -0,0 +1,182 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<spi.h>
+ *
+ * [MODULE]:		<SPI>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<11/11/2020>
+ *
+ * [DESCRIPTION]:	<Header file for the SPI driver>
+ *
+ *******************************************************************************/
+#ifndef SPI_H_
+#define SPI_H_
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Mode number is CPOL:CPHA, value is already in SPCR position */
+typedef enum
+{
+	SPI_MODE0=0x00,SPI_MODE1=0x04,SPI_MODE2=0x08,SPI_MODE3=0x0C
+}SPI_Mode;
+
+typedef enum
+{
+	MSB_FIRST=0x00,LSB_FIRST=0x20
+}SPI_BitOrder;
+
+/* F_CPU divider, bits 1:0 are SPR1:0 and bit 2 is SPI2X */
+typedef enum
+{
+	SPI_CLK_4,SPI_CLK_16,SPI_CLK_64,SPI_CLK_128,SPI_CLK_2,SPI_CLK_8,SPI_CLK_32
+}SPI_Clock;
+
+/* One device on the bus, chip select is active low */
+typedef struct
+{
+	SPI_Mode		s_mode;
+	SPI_BitOrder	s_bit_order;
+	SPI_Clock		s_clock;
+	volatile uint8	*s_cs_port_Ptr;		/* PORTx of chip select, e.g. &PORTB */
+	uint8			s_cs_pin;
+}SPI_DeviceConfigType;
+
+/* Register map served by the slave, first byte of a frame is the address,
+ * with SPI_SLAVE_WRITE set the next bytes are written else they are read */
+typedef struct
+{
+	uint8		*s_registers_Ptr;
+	const uint8	*s_read_only_Ptr;	/* Per register, bits set can not be written, NULL_PTR all writable */
+	uint8		s_count;
+	bool		s_auto_increment;	/* Move to next register after every data byte, stops at
+									 * s_count: later writes are ignored, reads give 0xFF */
+}SPI_SlaveMapType;
+
+/* One queued transfer, chip select of s_device is driven by the queue */
+typedef struct
+{
+	uint8		s_device;			/* Index in the SPI_initDevices table */
+	const uint8	*s_tx_Ptr;			/* NULL_PTR sends SPI_DUMMY_BYTE */
+	uint8		*s_rx_Ptr;			/* NULL_PTR drops received bytes */
+	uint16		s_length;
+	uint8		s_priority;			/* 0 is served first, below SPI_QUEUE_PRIORITIES */
+	void(*s_done_callBack_Ptr)(void);	/* Called from SPI_STC_vect, can be NULL_PTR */
+}SPI_TransactionType;
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Number of devices SPI_initDevices can hold */
+#define SPI_MAX_DEVICES 4
+
+/* SPI_select value meaning no device is selected */
+#define SPI_NO_DEVICE 0xFF
+
+/* Sent by SPI_transfer when no transmit buffer is given */
+#define SPI_DUMMY_BYTE 0xFF
+
+/* Address byte flag asking the slave to write the register map */
+#define SPI_SLAVE_WRITE 0x80
+
+/* Transactions SPI_submit can hold, up to 254 */
+#define SPI_QUEUE_SIZE 8
+
+/* Priority levels of the queue, 1 makes it a plain FIFO */
+#define SPI_QUEUE_PRIORITIES 2
+
+/* INTERRUPT ENABLE */
+#define SPI_INTENABLE 0
+
+/* Send MSB first write 0
+ * Send LSB first write 1
+ */
+#define SPI_DORD 0
+
+/* Clock Polarity with Rising write 0 with falling write 1 */
+#define SPI_CLKPOL 0
+
+/* factor to divide F_CPU with WRITE
+ * 0 ----> F_CPU/4
+ * 1 ----> F_CPU/16
+ * 2 ----> F_CPU/64
+ * 3 ----> F_CPU/128
+ */
+#define SPI_CLKRATE  0x00
+
+/* To enable double speed write 1 */
+#define SPI_DOUPLESPEED 0
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/* This function is responsible for initializing the SPI's Master */
+void SPI_initMaster(void);
+
+/* This function is responsible for initializing the SPI's Slave */
+void SPI_initSlave(void);
+
+/* This function is responsible for sending one byte */
+void SPI_sendByte(const uint8 data);
+
+/* This function is responsible for receiving one byte */
+uint8 SPI_receiveByte(void);
+
+/* This function is responsible for sending String */
+void SPI_sendString(const uint8 *Str);
+
+/* This function is responsible for receiving String */
+void SPI_receiveString(uint8 *Str);
+
+/* This function is responsible for sending a buffer with no idle time between bytes */
+void SPI_writeBurst(const uint8 *a_data_Ptr,uint16 a_length);
+
+/* This function is responsible for receiving a buffer with no idle time between bytes */
+void SPI_readBurst(uint8 *a_data_Ptr,uint16 a_length);
+
+/* This function is responsible for exchanging a buffer with no idle time between bytes */
+void SPI_exchangeBurst(const uint8 *a_tx_Ptr,uint8 *a_rx_Ptr,uint16 a_length);
+
+/* This function is responsible for precomputing SPCR/SPSR of every device on the bus */
+void SPI_initDevices(const SPI_DeviceConfigType *a_devices_Ptr,uint8 a_count);
+
+/* This function is responsible for setting the bus for a device and asserting its chip select */
+void SPI_select(uint8 a_device);
+
+/* This function is responsible for releasing chip select of the selected device */
+void SPI_deselect(void);
+
+/* This function is responsible for starting an interrupt driven full-duplex transfer */
+bool SPI_transfer(const uint8 *a_tx_Ptr,uint8 *a_rx_Ptr,uint16 a_length,void(*a_done_callBack_Ptr)(void));
+
+/* This function is responsible for telling if SPI_transfer is still running */
+bool SPI_isBusy(void);
+
+/* This function is responsible for initializing the slave to serve a register map */
+void SPI_initSlaveMap(const SPI_SlaveMapType *a_map_Ptr);
+
+/* This function is responsible for starting a new slave frame, call it when SS goes high */
+void SPI_slaveFrameEnd(void);
+
+/* This function is responsible for emptying the transaction queue */
+void SPI_initQueue(void);
+
+/* This function is responsible for adding a transaction to the queue, safe from ISRs */
+bool SPI_submit(const SPI_TransactionType *a_transaction_Ptr);
+
+/*This function is responsible for saving the address that will be called after interrupts happen*/
+void SPI_callBackAdress(void(*a_Func_Ptr)(void));
+
+#endif /* SPI_H_ */
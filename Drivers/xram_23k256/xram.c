@@ -0,0 +1,309 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<xram.c>
+ *
+ * [MODULE]:		<XRAM>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Source file for the 23K256 serial SRAM driver with page cache>
+ * 					<Direct-mapped cache, page n lives in line n%XRAM_CACHE_PAGES,
+ * 					 dirty lines are written back when replaced>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "xram.h"
+
+#if ((XRAM_PAGE_SIZE & (XRAM_PAGE_SIZE-1)) != 0) || ((XRAM_CACHE_PAGES & (XRAM_CACHE_PAGES-1)) != 0)
+#error "XRAM_PAGE_SIZE and XRAM_CACHE_PAGES must be powers of two"
+#endif
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint8 s_data[XRAM_PAGE_SIZE];
+	uint16 s_page;			/* Chip page held by the line */
+	bool s_valid;
+	bool s_dirty;
+}XRAM_LineType;
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+/* Device index of the chip in the SPI table */
+static uint8 g_device=SPI_NO_DEVICE;
+
+static XRAM_LineType g_cache[XRAM_CACHE_PAGES];
+
+#if(XRAM_STATS==1)
+static XRAM_StatsType g_stats;
+#endif
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	XRAM_transfer
+ *  [Description] :		This function is responsible for moving one page between
+ *  					the chip and a cache line with a sequential access
+ *  [Args] :
+ *  [in]				uint8 a_command:
+ *  						XRAM_CMD_READ or XRAM_CMD_WRITE
+ *  [out]				None
+ *  [in/out]			XRAM_LineType *a_line_Ptr:
+ *  						line to fill or write back
+ *  [Returns]			None
+ *********************************************************************************/
+static void XRAM_transfer(uint8 a_command,XRAM_LineType *a_line_Ptr){
+	uint16 address=a_line_Ptr->s_page*XRAM_PAGE_SIZE;
+	uint8 header[3];
+
+	header[0]=a_command;
+	header[1]=(uint8)(address>>8);
+	header[2]=(uint8)(address);
+
+	SPI_select(g_device);
+	SPI_writeBurst(header,sizeof(header));
+	if(a_command==XRAM_CMD_READ){
+		SPI_readBurst(a_line_Ptr->s_data,XRAM_PAGE_SIZE);
+	}
+	else{
+		SPI_writeBurst(a_line_Ptr->s_data,XRAM_PAGE_SIZE);
+	}
+	SPI_deselect();
+}
+
+/********************************************************************************
+ *  [Function Name]:	XRAM_getLine
+ *  [Description] :		This function is responsible for returning the line that
+ *  					holds an address, loading its page on a miss
+ *  [Args] :
+ *  [in]				uint16 a_address:
+ *  						chip address
+ *  					bool a_fill:
+ *  						FALSE when the whole page is about to be written so
+ *  						a miss does not read it from the chip
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			The cache line
+ *********************************************************************************/
+static XRAM_LineType *XRAM_getLine(uint16 a_address,bool a_fill){
+	uint16 page=a_address/XRAM_PAGE_SIZE;
+	XRAM_LineType *line_Ptr=&g_cache[page & (XRAM_CACHE_PAGES-1)];
+
+	if(line_Ptr->s_valid && line_Ptr->s_page==page){
+#if(XRAM_STATS==1)
+		g_stats.s_hits++;
+#endif
+		return line_Ptr;
+	}
+
+#if(XRAM_STATS==1)
+	g_stats.s_misses++;
+#endif
+	if(line_Ptr->s_valid && line_Ptr->s_dirty){
+		XRAM_transfer(XRAM_CMD_WRITE,line_Ptr);
+#if(XRAM_STATS==1)
+		g_stats.s_write_backs++;
+#endif
+	}
+	line_Ptr->s_page=page;
+	line_Ptr->s_valid=TRUE;
+	line_Ptr->s_dirty=FALSE;
+	if(a_fill){
+		XRAM_transfer(XRAM_CMD_READ,line_Ptr);
+	}
+	return line_Ptr;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	XRAM_init
+ *  [Description] :		This function is responsible for putting the chip in
+ *  					sequential mode and emptying the cache, SPI_initMaster
+ *  					and SPI_initDevices must be called first
+ *  [Args] :
+ *  [in]				uint8 a_device:
+ *  						index of the chip in the SPI_initDevices table
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void XRAM_init(uint8 a_device){
+	uint8 command[2]={XRAM_CMD_WRITE_STATUS,XRAM_SEQUENTIAL_MODE};
+	uint8 i;
+
+	g_device=a_device;
+	for(i=0;i<XRAM_CACHE_PAGES;i++){
+		g_cache[i].s_valid=FALSE;
+		g_cache[i].s_dirty=FALSE;
+	}
+#if(XRAM_STATS==1)
+	g_stats.s_hits=0;
+	g_stats.s_misses=0;
+	g_stats.s_write_backs=0;
+#endif
+
+	SPI_select(g_device);
+	SPI_writeBurst(command,sizeof(command));
+	SPI_deselect();
+}
+
+/********************************************************************************
+ *  [Function Name]:	XRAM_read
+ *  [Description] :		This function is responsible for reading bytes through
+ *  					the cache
+ *  [Args] :
+ *  [in]				uint16 a_address:
+ *  						first chip address, wraps at XRAM_SIZE
+ *  					uint16 a_length:
+ *  						number of bytes
+ *  [out]				uint8 *a_data_Ptr:
+ *  						pointer to address that data will be stored at
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void XRAM_read(uint16 a_address,uint8 *a_data_Ptr,uint16 a_length){
+	XRAM_LineType *line_Ptr;
+	uint16 offset;
+	uint16 count;
+	uint16 i;
+
+	while(a_length>0){
+		a_address&=(XRAM_SIZE-1);
+		line_Ptr=XRAM_getLine(a_address,TRUE);
+		offset=a_address & (XRAM_PAGE_SIZE-1);
+		count=XRAM_PAGE_SIZE-offset;
+		if(count>a_length){
+			count=a_length;
+		}
+		for(i=0;i<count;i++){
+			a_data_Ptr[i]=line_Ptr->s_data[offset+i];
+		}
+		a_address+=count;
+		a_data_Ptr+=count;
+		a_length-=count;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	XRAM_write
+ *  [Description] :		This function is responsible for writing bytes through
+ *  					the cache, the chip is written when the line is replaced
+ *  					or on XRAM_flush
+ *  [Args] :
+ *  [in]				uint16 a_address:
+ *  						first chip address, wraps at XRAM_SIZE
+ *  					const uint8 *a_data_Ptr:
+ *  						bytes to write
+ *  					uint16 a_length:
+ *  						number of bytes
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void XRAM_write(uint16 a_address,const uint8 *a_data_Ptr,uint16 a_length){
+	XRAM_LineType *line_Ptr;
+	uint16 offset;
+	uint16 count;
+	uint16 i;
+
+	while(a_length>0){
+		a_address&=(XRAM_SIZE-1);
+		offset=a_address & (XRAM_PAGE_SIZE-1);
+		count=XRAM_PAGE_SIZE-offset;
+		if(count>a_length){
+			count=a_length;
+		}
+		/* A write of the whole page needs nothing of it from the chip */
+		line_Ptr=XRAM_getLine(a_address,count!=XRAM_PAGE_SIZE);
+		for(i=0;i<count;i++){
+			line_Ptr->s_data[offset+i]=a_data_Ptr[i];
+		}
+		line_Ptr->s_dirty=TRUE;
+		a_address+=count;
+		a_data_Ptr+=count;
+		a_length-=count;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	XRAM_ptr
+ *  [Description] :		This function is responsible for returning a pointer to
+ *  					a cached byte, the line is marked dirty since it may be
+ *  					written through the pointer
+ *  [Args] :
+ *  [in]				uint16 a_address:
+ *  						chip address, wraps at XRAM_SIZE
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Pointer valid up to the end of the page and only until
+ *  					the next XRAM call
+ *********************************************************************************/
+uint8 *XRAM_ptr(uint16 a_address){
+	XRAM_LineType *line_Ptr;
+
+	a_address&=(XRAM_SIZE-1);
+	line_Ptr=XRAM_getLine(a_address,TRUE);
+	line_Ptr->s_dirty=TRUE;
+	return &line_Ptr->s_data[a_address & (XRAM_PAGE_SIZE-1)];
+}
+
+/********************************************************************************
+ *  [Function Name]:	XRAM_flush
+ *  [Description] :		This function is responsible for writing every dirty
+ *  					page to the chip, the lines stay cached
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void XRAM_flush(void){
+	uint8 i;
+
+	for(i=0;i<XRAM_CACHE_PAGES;i++){
+		if(g_cache[i].s_valid && g_cache[i].s_dirty){
+			XRAM_transfer(XRAM_CMD_WRITE,&g_cache[i]);
+			g_cache[i].s_dirty=FALSE;
+#if(XRAM_STATS==1)
+			g_stats.s_write_backs++;
+#endif
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	XRAM_getStats
+ *  [Description] :		This function is responsible for copying the cache
+ *  					counters, all zero when XRAM_STATS is 0
+ *  [Args] :
+ *  [in]				None
+ *  [out]				XRAM_StatsType *a_stats_Ptr:
+ *  						pointer to structure the counters are copied to
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+void XRAM_getStats(XRAM_StatsType *a_stats_Ptr){
+#if(XRAM_STATS==1)
+	*a_stats_Ptr=g_stats;
+#else
+	a_stats_Ptr->s_hits=0;
+	a_stats_Ptr->s_misses=0;
+	a_stats_Ptr->s_write_backs=0;
+#endif
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<xram.h>
+ *
+ * [MODULE]:		<XRAM>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Header file for the 23K256 serial SRAM driver with page cache>
+ *
+ *******************************************************************************/
+#ifndef XRAM_H_
+#define XRAM_H_
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "spi.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Cache counters, hit rate is s_hits/(s_hits+s_misses) */
+typedef struct
+{
+	uint32 s_hits;
+	uint32 s_misses;
+	uint32 s_write_backs;		/* Dirty pages written to the chip */
+}XRAM_StatsType;
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Chip size */
+#define XRAM_SIZE 32768UL
+
+/* Cache geometry, both powers of two, RAM used is their product,
+ * a page can be up to 256 bytes in sequential mode */
+#define XRAM_PAGE_SIZE   32
+#define XRAM_CACHE_PAGES 8
+
+/* To count hits and misses write 1 */
+#define XRAM_STATS 1
+
+/* Commands */
+#define XRAM_CMD_READ			0x03
+#define XRAM_CMD_WRITE			0x02
+#define XRAM_CMD_WRITE_STATUS	0x01
+
+/* Status value for sequential mode with HOLD disabled */
+#define XRAM_SEQUENTIAL_MODE 0x41
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/* This function is responsible for putting the chip on a device of the SPI table in sequential mode */
+void XRAM_init(uint8 a_device);
+
+/* This function is responsible for reading bytes through the cache */
+void XRAM_read(uint16 a_address,uint8 *a_data_Ptr,uint16 a_length);
+
+/* This function is responsible for writing bytes through the cache */
+void XRAM_write(uint16 a_address,const uint8 *a_data_Ptr,uint16 a_length);
+
+/* This function is responsible for returning a pointer to a cached byte */
+uint8 *XRAM_ptr(uint16 a_address);
+
+/* This function is responsible for writing every dirty page to the chip */
+void XRAM_flush(void);
+
+/* This function is responsible for copying the cache counters */
+void XRAM_getStats(XRAM_StatsType *a_stats_Ptr);
+
+#endif /* XRAM_H_ */
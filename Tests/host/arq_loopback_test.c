@@ -0,0 +1,262 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<arq_loopback_test.c>
+ *
+ * [MODULE]:		<HOST TESTS>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Runs arq.c and packet.c over a looped back line in place of>
+ * 					<the UART and timer drivers. The node receives its own DATA>
+ * 					<and ACK frames, bytes are dropped or corrupted on the way.>
+ * 					<Checks in order delivery and reports goodput as a fraction>
+ * 					<of the raw line rate>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "timer.h"
+#include "arq.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Line model, 10 bits per character, one loop step is one character time */
+#define TEST_BAUD			9600UL
+#define TEST_STEPS_PER_TICK	((TEST_BAUD/10UL)*ARQ_TICK_MS/1000UL)
+
+/* Bytes in flight on the line, power of two */
+#define LINE_SIZE 65536UL
+
+#define TEST_FRAMES		2000
+#define TEST_MAX_STEPS	10000000UL
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	const char	*s_name_Ptr;
+	uint16		s_loss;			/* Bytes dropped per 1000 */
+	uint16		s_corruption;	/* Bytes with one bit flipped per 1000 */
+}TEST_ScenarioType;
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+static const TEST_ScenarioType g_scenarios[]={
+	{"clean line",0,0},
+	{"1% byte loss",10,0},
+	{"1% byte corruption",0,10},
+	{"3% loss + 2% corruption",30,20},
+};
+
+/* Looped back line */
+static uint8 g_line[LINE_SIZE];
+static uint32 g_lineHead=0;
+static uint32 g_lineTail=0;
+
+static void(*g_rxHandler_Ptr)(uint8 a_data,uint8 a_status)=NULL_PTR;
+static void(*g_tick_Ptr)(void)=NULL_PTR;
+
+/* Delivery check, frame n carries length and bytes made from n */
+static uint16 g_nextExpected=0;
+static bool g_orderError=FALSE;
+
+/*******************************************************************************
+ *              Replacement of the UART and timer driver functions             *
+ *******************************************************************************/
+
+void UART_init(const UART_ConfigType *a_config_Ptr){
+	(void)a_config_Ptr;
+}
+
+uint16 UART_write(const uint8 *a_data_Ptr,uint16 a_length){
+	uint16 i;
+
+	for(i=0;i<a_length;i++){
+		if(g_lineHead-g_lineTail>=LINE_SIZE){
+			printf("FAIL arq loopback: line overflow\n");
+			exit(1);
+		}
+		g_line[g_lineHead & (LINE_SIZE-1)]=a_data_Ptr[i];
+		g_lineHead++;
+	}
+	return a_length;
+}
+
+void UART_setReceiveHandler(void(*a_handler_Ptr)(uint8 a_data,uint8 a_status)){
+	g_rxHandler_Ptr=a_handler_Ptr;
+}
+
+void TIMER_init(const Timer_ConfigType *a_config_Ptr){
+	(void)a_config_Ptr;
+}
+
+void TIMER_setCallBack(uint8 a_timerID,void(*a_ptr)(void)){
+	(void)a_timerID;
+	g_tick_Ptr=a_ptr;
+}
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	TEST_makeFrame
+ *  [Description] :		This function is responsible for building frame number
+ *  					a_number of the test stream
+ *  [Args] :
+ *  [in]				uint16 a_number:
+ *  						frame number
+ *  [out]				uint8 *a_data_Ptr:
+ *  						payload
+ *  [in/out]			None
+ *  [Returns]			Payload length, 1 to ARQ_MAX_PAYLOAD
+ *********************************************************************************/
+static uint8 TEST_makeFrame(uint16 a_number,uint8 *a_data_Ptr){
+	uint8 length=(uint8)(1+(a_number*7)%ARQ_MAX_PAYLOAD);
+	uint8 i;
+
+	for(i=0;i<length;i++){
+		a_data_Ptr[i]=(uint8)(a_number*31+i*13);
+	}
+	return length;
+}
+
+/********************************************************************************
+ *  [Function Name]:	TEST_received
+ *  [Description] :		This function is responsible for checking every frame
+ *  					ARQ delivers is the next one of the stream
+ *  [Args] :
+ *  [in]				const uint8 *a_data_Ptr:
+ *  						payload
+ *  					uint8 a_length:
+ *  						payload length
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void TEST_received(const uint8 *a_data_Ptr,uint8 a_length){
+	uint8 expected[ARQ_MAX_PAYLOAD];
+	uint8 length=TEST_makeFrame(g_nextExpected,expected);
+	uint8 i;
+
+	if(a_length!=length){
+		g_orderError=TRUE;
+	}
+	for(i=0;i<length && !g_orderError;i++){
+		if(a_data_Ptr[i]!=expected[i]){
+			g_orderError=TRUE;
+		}
+	}
+	g_nextExpected++;
+}
+
+/********************************************************************************
+ *  [Function Name]:	TEST_run
+ *  [Description] :		This function is responsible for pushing the stream
+ *  					through one line scenario
+ *  [Args] :
+ *  [in]				const TEST_ScenarioType *a_scenario_Ptr:
+ *  						loss and corruption of the line
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			TRUE when every frame arrived once and in order
+ *********************************************************************************/
+static bool TEST_run(const TEST_ScenarioType *a_scenario_Ptr){
+	UART_ConfigType uart={0};
+	ARQ_StatsType before;
+	ARQ_StatsType after;
+	uint8 payload[ARQ_MAX_PAYLOAD];
+	uint8 length;
+	uint8 data;
+	uint16 sent=0;
+	uint16 chance;
+	uint32 total=0;
+	uint32 steps=0;
+
+	g_lineHead=0;
+	g_lineTail=0;
+	g_nextExpected=0;
+	g_orderError=FALSE;
+	ARQ_init(&uart,TEST_received);
+	ARQ_getStats(&before);
+	after=before;
+
+	while(steps<TEST_MAX_STEPS){
+		/* Offer the next frame whenever the window has room */
+		if(sent<TEST_FRAMES){
+			length=TEST_makeFrame(sent,payload);
+			if(ARQ_send(payload,length)){
+				sent++;
+				total+=length;
+			}
+		}
+		ARQ_poll();
+		ARQ_getStats(&after);
+		if(sent==TEST_FRAMES && g_nextExpected>=TEST_FRAMES && after.s_acked_bytes-before.s_acked_bytes==total){
+			break;
+		}
+
+		/* One character time on the line */
+		if(g_lineTail!=g_lineHead){
+			data=g_line[g_lineTail & (LINE_SIZE-1)];
+			g_lineTail++;
+			chance=(uint16)(rand()%1000);
+			if(chance>=a_scenario_Ptr->s_loss){
+				if(chance<a_scenario_Ptr->s_loss+a_scenario_Ptr->s_corruption){
+					data^=(uint8)(1<<(rand()%8));
+				}
+				(*g_rxHandler_Ptr)(data,0);
+			}
+		}
+		steps++;
+		if(steps%TEST_STEPS_PER_TICK==0){
+			(*g_tick_Ptr)();
+		}
+	}
+
+	printf("arq_loopback %-24s: %5lu chars, %4u sent, %4u resent, %4u duplicates, goodput %4.1f%% of raw\n",
+			a_scenario_Ptr->s_name_Ptr,(unsigned long)steps,
+			(unsigned)(after.s_sent-before.s_sent),(unsigned)(after.s_retransmits-before.s_retransmits),
+			(unsigned)(after.s_duplicates-before.s_duplicates),100.0*(double)total/(double)steps);
+
+	if(steps>=TEST_MAX_STEPS){
+		printf("FAIL arq loopback: stream did not finish, %u of %u frames delivered\n",g_nextExpected,TEST_FRAMES);
+		return FALSE;
+	}
+	if(g_orderError || g_nextExpected!=TEST_FRAMES){
+		printf("FAIL arq loopback: frames delivered out of order, changed or twice\n");
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void){
+	bool passed=TRUE;
+	uint8 i;
+
+	srand(1);
+	for(i=0;i<sizeof(g_scenarios)/sizeof(g_scenarios[0]);i++){
+		if(!TEST_run(&g_scenarios[i])){
+			passed=FALSE;
+		}
+	}
+	return passed ? 0 : 1;
+}
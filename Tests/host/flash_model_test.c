@@ -0,0 +1,291 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<flash_model_test.c>
+ *
+ * [MODULE]:		<HOST TESTS>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Runs flash.c against a 64KB W25Qxx model in place of the SPI>
+ * 					<driver. The model only clears bits on program, needs write>
+ * 					<enable before program/erase and stays busy for a while after>
+ * 					<them, random reads/writes/erases are compared with a RAM copy>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "flash.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* JEDEC capacity byte 0x10 is 64KB */
+#define MODEL_CAPACITY_CODE	0x10
+#define MODEL_SIZE			(1UL<<MODEL_CAPACITY_CODE)
+
+/* Status reads answered busy after a program or erase */
+#define MODEL_BUSY_POLLS 3
+
+#define TEST_ITERATIONS	3000
+#define TEST_MAX_LENGTH	600
+
+/* FLASH_init again after this many operations, as after a reset */
+#define TEST_RESET_EVERY 500
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+static uint8 g_memory[MODEL_SIZE];
+static uint8 g_expected[MODEL_SIZE];
+
+/* Command in progress, reset by chip select */
+static bool g_selected=FALSE;
+static uint32 g_position=0;
+static uint8 g_command=0;
+static uint32 g_address=0;
+static bool g_write_enabled=FALSE;
+static uint8 g_busy=0;
+
+static uint32 g_programs=0;
+static uint32 g_erases=0;
+static uint32 g_sector_erases[MODEL_SIZE/FLASH_SECTOR_SIZE];
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	MODEL_fail
+ *  [Description] :		This function is responsible for stopping the test on a
+ *  					command the real chip would reject
+ *  [Args] :
+ *  [in]				const char *a_reason_Ptr:
+ *  						what went wrong
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void MODEL_fail(const char *a_reason_Ptr){
+	printf("FAIL flash model: %s (command 0x%02X)\n",a_reason_Ptr,g_command);
+	exit(1);
+}
+
+/********************************************************************************
+ *  [Function Name]:	MODEL_exchange
+ *  [Description] :		This function is responsible for one byte on the bus
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						byte from the master
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Byte from the flash
+ *********************************************************************************/
+static uint8 MODEL_exchange(uint8 a_data){
+	static const uint8 id[3]={0xEF,0x40,MODEL_CAPACITY_CODE};
+	uint8 result=0xFF;
+	uint32 address;
+
+	if(!g_selected){
+		MODEL_fail("byte sent without chip select");
+	}
+	if(g_position==0){
+		g_command=a_data;
+		g_address=0;
+		if(g_busy!=0 && g_command!=FLASH_CMD_READ_STATUS){
+			MODEL_fail("command while busy");
+		}
+	}
+	else if(g_command==FLASH_CMD_JEDEC_ID){
+		result=id[(g_position-1)%3];
+	}
+	else if(g_command==FLASH_CMD_READ_STATUS){
+		if(g_busy!=0){
+			g_busy--;
+			result=FLASH_STATUS_BUSY;
+		}
+		else{
+			result=0;
+		}
+	}
+	else if(g_position<=3){
+		g_address=(g_address<<8) | a_data;
+	}
+	else if(g_command==FLASH_CMD_FAST_READ){
+		/* Fifth byte is the dummy one */
+		if(g_position>=5){
+			result=g_memory[g_address%MODEL_SIZE];
+			g_address++;
+		}
+	}
+	else if(g_command==FLASH_CMD_PAGE_PROGRAM){
+		if(!g_write_enabled){
+			MODEL_fail("program without write enable");
+		}
+		/* Address wraps inside the page, programming only clears bits */
+		address=(g_address & ~(FLASH_PAGE_SIZE-1)) | ((g_address+g_position-4) & (FLASH_PAGE_SIZE-1));
+		g_memory[address%MODEL_SIZE]&=a_data;
+	}
+	g_position++;
+	return result;
+}
+
+/*******************************************************************************
+ *                 Replacement of the SPI driver functions                     *
+ *******************************************************************************/
+
+void SPI_select(uint8 a_device){
+	(void)a_device;
+	g_selected=TRUE;
+	g_position=0;
+}
+
+void SPI_deselect(void){
+	uint32 size;
+	uint32 address;
+
+	if(g_command==FLASH_CMD_SECTOR_ERASE || g_command==FLASH_CMD_BLOCK_ERASE){
+		if(g_position<4 || !g_write_enabled){
+			MODEL_fail("erase without address or write enable");
+		}
+		size=(g_command==FLASH_CMD_SECTOR_ERASE) ? FLASH_SECTOR_SIZE : FLASH_BLOCK_SIZE;
+		memset(&g_memory[g_address & ~(size-1)],0xFF,size);
+		for(address=g_address & ~(size-1);address<(g_address & ~(size-1))+size;address+=FLASH_SECTOR_SIZE){
+			g_sector_erases[(address%MODEL_SIZE)/FLASH_SECTOR_SIZE]++;
+		}
+		g_write_enabled=FALSE;
+		g_busy=MODEL_BUSY_POLLS;
+		g_erases++;
+	}
+	else if(g_command==FLASH_CMD_PAGE_PROGRAM){
+		g_write_enabled=FALSE;
+		g_busy=MODEL_BUSY_POLLS;
+		g_programs++;
+	}
+	else if(g_command==FLASH_CMD_WRITE_ENABLE){
+		g_write_enabled=TRUE;
+	}
+	g_selected=FALSE;
+	g_command=0;
+}
+
+void SPI_sendByte(const uint8 data){
+	MODEL_exchange(data);
+}
+
+void SPI_writeBurst(const uint8 *a_data_Ptr,uint16 a_length){
+	while(a_length--){
+		MODEL_exchange(*a_data_Ptr++);
+	}
+}
+
+void SPI_readBurst(uint8 *a_data_Ptr,uint16 a_length){
+	while(a_length--){
+		*a_data_Ptr++=MODEL_exchange(SPI_DUMMY_BYTE);
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void){
+	uint8 buffer[TEST_MAX_LENGTH];
+	uint32 capacity;
+	uint32 address;
+	uint16 length;
+	uint16 i;
+	uint32 first;
+	uint32 least;
+	uint32 most;
+	int iteration;
+
+	memset(g_memory,0xFF,sizeof(g_memory));
+	memset(g_expected,0xFF,sizeof(g_expected));
+	srand(1);
+
+	if(FLASH_init(0)!=SUCCESS){
+		printf("FAIL flash model: FLASH_init\n");
+		return 1;
+	}
+	capacity=FLASH_getCapacity();
+	if(capacity!=MODEL_SIZE-FLASH_SCRATCH_SECTORS*FLASH_SECTOR_SIZE){
+		printf("FAIL flash model: capacity %lu\n",(unsigned long)capacity);
+		return 1;
+	}
+
+	for(iteration=0;iteration<TEST_ITERATIONS;iteration++){
+		address=(uint32)rand()%(capacity-TEST_MAX_LENGTH);
+		length=(uint16)(rand()%TEST_MAX_LENGTH);
+
+		if(rand()%3!=0){
+			for(i=0;i<length;i++){
+				buffer[i]=(uint8)rand();
+			}
+			FLASH_write(address,buffer,length);
+			memcpy(&g_expected[address],buffer,length);
+		}
+		else{
+			FLASH_read(address,buffer,length);
+			if(memcmp(buffer,&g_expected[address],length)!=0){
+				printf("FAIL flash model: read mismatch at iteration %d\n",iteration);
+				return 1;
+			}
+		}
+
+		/* After a flush the chip itself must hold the data */
+		if(rand()%50==0){
+			FLASH_flush();
+			if(memcmp(g_memory,g_expected,capacity)!=0){
+				printf("FAIL flash model: chip differs after flush at iteration %d\n",iteration);
+				return 1;
+			}
+		}
+		if(rand()%200==0){
+			FLASH_eraseSector(address);
+			memset(&g_expected[address & ~(FLASH_SECTOR_SIZE-1)],0xFF,FLASH_SECTOR_SIZE);
+		}
+		/* The scratch turn must survive a reset */
+		if(iteration%TEST_RESET_EVERY==TEST_RESET_EVERY-1){
+			FLASH_flush();
+			FLASH_init(0);
+		}
+	}
+
+	FLASH_flush();
+	if(memcmp(g_memory,g_expected,capacity)!=0){
+		printf("FAIL flash model: chip differs at the end\n");
+		return 1;
+	}
+
+	/* Scratch sectors follow the counter sector, their erases must stay even,
+	 * a restart of the counter page may give some of them one more */
+	first=capacity/FLASH_SECTOR_SIZE+1;
+	least=g_sector_erases[first];
+	most=least;
+	for(i=first;i<MODEL_SIZE/FLASH_SECTOR_SIZE;i++){
+		if(g_sector_erases[i]<least){
+			least=g_sector_erases[i];
+		}
+		if(g_sector_erases[i]>most){
+			most=g_sector_erases[i];
+		}
+	}
+	printf("flash_model: %d operations, %lu page programs, %lu erases, scratch erases %lu to %lu, 0 failures\n",
+			TEST_ITERATIONS,(unsigned long)g_programs,(unsigned long)g_erases,(unsigned long)least,(unsigned long)most);
+	if(most-least>1+g_sector_erases[first-1]){
+		printf("FAIL flash model: scratch sectors wear unevenly\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,243 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<modbus_gap_test.c>
+ *
+ * [MODULE]:		<HOST TESTS>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Runs modbus.c against a cycle stepped TIMER1 and a receive>
+ * 					<line where every byte arrives one character time after the>
+ * 					<previous one plus a chosen silence. Frames with gaps below>
+ * 					<t1.5 must be answered, frames with gaps above it dropped>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+#include "timer.h"
+#include "modbus.h"
+
+#include <stdio.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Same character and t1.5 as the standard, 11 bits and 750us above 19200 */
+#define TEST_CHAR_BITS		11UL
+#define TEST_T15_US(BAUD)	(((BAUD)>19200UL) ? 750UL : TEST_CHAR_BITS*1500000UL/(BAUD))
+#define TEST_CHAR_US(BAUD)	(TEST_CHAR_BITS*1000000UL/(BAUD))
+
+/* modbus.c selects the TIMER1 compare B call back with this id */
+#define TEST_TIMER1B_ID 3
+
+#define TEST_SLAVE 1
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+static const uint32 g_bauds[]={1200UL,9600UL,19200UL,38400UL,115200UL};
+
+static uint16 g_registers[4]={0x1234,0x5678,0x9ABC,0xDEF0};
+
+/* TIMER1 model, counts CPU cycles through the prescaler */
+static bool g_timerRunning=FALSE;
+static uint16 g_prescale=1;
+static uint16 g_residue=0;
+static uint16 g_count=0;
+static uint16 g_compareA=0;
+static uint16 g_compareB=0;
+static void(*g_compareA_Ptr)(void)=NULL_PTR;
+static void(*g_compareB_Ptr)(void)=NULL_PTR;
+
+static void(*g_rxHandler_Ptr)(uint8 a_data,uint8 a_status)=NULL_PTR;
+static void(*g_txComplete_Ptr)(void)=NULL_PTR;
+static uint16 g_replyLength=0;
+
+/*******************************************************************************
+ *              Replacement of the UART and timer driver functions             *
+ *******************************************************************************/
+
+void UART_init(const UART_ConfigType *a_config_Ptr){
+	(void)a_config_Ptr;
+}
+
+uint16 UART_write(const uint8 *a_data_Ptr,uint16 a_length){
+	(void)a_data_Ptr;
+	g_replyLength+=a_length;
+	return a_length;
+}
+
+uint8 UART_txPending(void){
+	return 0;
+}
+
+void UART_setReceiveHandler(void(*a_handler_Ptr)(uint8 a_data,uint8 a_status)){
+	g_rxHandler_Ptr=a_handler_Ptr;
+}
+
+void UART_callBackAdress(void(*a_Func_Ptr)(void),uint8 TorR){
+	if(TorR==2){
+		g_txComplete_Ptr=a_Func_Ptr;
+	}
+}
+
+void TIMER_init(const Timer_ConfigType *a_config_Ptr){
+	static const uint16 prescalers[]={0,1,8,64,256,1024};
+
+	g_prescale=prescalers[a_config_Ptr->s_timer_clk];
+	g_compareA=a_config_Ptr->s_timer_compare_value;
+	g_compareB=a_config_Ptr->s_timer1B_compare_value;
+	g_residue=0;
+	g_count=a_config_Ptr->s_timer_initial_value;
+	g_timerRunning=TRUE;
+}
+
+void TIMER_setCallBack(uint8 a_timerID,void(*a_ptr)(void)){
+	if(a_timerID==TIMER1){
+		g_compareA_Ptr=a_ptr;
+	}
+	else if(a_timerID==TEST_TIMER1B_ID){
+		g_compareB_Ptr=a_ptr;
+	}
+}
+
+void TIMER_deinit(uint8 a_timerID){
+	(void)a_timerID;
+	g_timerRunning=FALSE;
+}
+
+void TIMER_restart(uint8 a_timerID){
+	(void)a_timerID;
+	g_residue=0;
+	g_count=0;
+}
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	TEST_advance
+ *  [Description] :		This function is responsible for running TIMER1 in CTC
+ *  					mode for a number of CPU cycles
+ *  [Args] :
+ *  [in]				uint32 a_cycles:
+ *  						CPU cycles
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void TEST_advance(uint32 a_cycles){
+	while(a_cycles-- && g_timerRunning){
+		g_residue++;
+		if(g_residue<g_prescale){
+			continue;
+		}
+		g_residue=0;
+		g_count++;
+		if(g_count==g_compareB){
+			(*g_compareB_Ptr)();
+		}
+		if(g_count==g_compareA){
+			g_count=0;
+			(*g_compareA_Ptr)();
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	TEST_frame
+ *  [Description] :		This function is responsible for sending one read request
+ *  					with the same silence between all its bytes and checking
+ *  					whether the slave answered it
+ *  [Args] :
+ *  [in]				uint32 a_baud:
+ *  						line baud rate
+ *  					uint32 a_gap_us:
+ *  						silence between two bytes in micro seconds
+ *  					bool a_accept:
+ *  						TRUE if the frame must be answered
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			TRUE if the slave did what was expected
+ *********************************************************************************/
+static bool TEST_frame(uint32 a_baud,uint32 a_gap_us,bool a_accept){
+	UART_ConfigType uart={0};
+	MODBUS_ConfigType config={&uart,TEST_SLAVE,g_registers,4,NULL_PTR};
+	MODBUS_StatsType before;
+	MODBUS_StatsType after;
+	uint8 request[8]={TEST_SLAVE,MODBUS_READ_HOLDING_REGISTERS,0,0,0,2};
+	uint32 character=F_CPU/1000UL*TEST_CHAR_US(a_baud)/1000UL;
+	uint32 gap=F_CPU/1000UL*a_gap_us/1000UL;
+	uint16 crc=0xFFFF;
+	bool answered;
+	bool dropped;
+	uint8 i;
+
+	uart.s_baudRate=a_baud;
+	MODBUS_init(&config);
+	for(i=0;i<6;i++){
+		crc=MODBUS_crcUpdate(crc,request[i]);
+	}
+	request[6]=(uint8)crc;
+	request[7]=(uint8)(crc>>8);
+
+	MODBUS_getStats(&before);
+	g_replyLength=0;
+	for(i=0;i<sizeof(request);i++){
+		if(i>0){
+			TEST_advance(gap);
+		}
+		/* RXC comes at the end of the character */
+		TEST_advance(character);
+		(*g_rxHandler_Ptr)(request[i],0);
+	}
+	/* Let t3.5 end the frame */
+	TEST_advance(4UL*character+F_CPU/1000UL*2UL);
+	MODBUS_poll();
+	(*g_txComplete_Ptr)();
+	MODBUS_getStats(&after);
+
+	/* Reply is address, function, byte count, two registers and CRC */
+	answered=(after.s_frames-before.s_frames==1 && g_replyLength==9);
+	dropped=(after.s_gap_errors-before.s_gap_errors==1 && after.s_frames==before.s_frames && g_replyLength==0);
+
+	printf("modbus_gap %6lu baud, gap %4lu us (%4.2f chars): %s\n",(unsigned long)a_baud,(unsigned long)a_gap_us,
+			(double)a_gap_us/(double)TEST_CHAR_US(a_baud),answered ? "answered" : dropped ? "dropped" : "lost");
+	if(a_accept ? !answered : !dropped){
+		printf("FAIL modbus gap: frame should have been %s\n",a_accept ? "answered" : "dropped");
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void){
+	bool passed=TRUE;
+	uint32 baud;
+	uint32 character;
+	uint32 t15;
+	uint8 i;
+
+	for(i=0;i<sizeof(g_bauds)/sizeof(g_bauds[0]);i++){
+		baud=g_bauds[i];
+		character=TEST_CHAR_US(baud);
+		t15=TEST_T15_US(baud);
+
+		passed&=TEST_frame(baud,0,TRUE);
+		passed&=TEST_frame(baud,character,TRUE);
+		passed&=TEST_frame(baud,t15-character/10UL,TRUE);
+		passed&=TEST_frame(baud,t15+character/2UL,FALSE);
+	}
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<interrupt.h>
+ *
+ * [MODULE]:		<HOST SHIM>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Stand-in for avr/interrupt.h, an ISR is a plain function>
+ * 					<the test calls to play the interrupt>
+ *
+ *******************************************************************************/
+#ifndef SHIM_AVR_INTERRUPT_H_
+#define SHIM_AVR_INTERRUPT_H_
+
+#define ISR(VECTOR) void VECTOR(void)
+#define sei()
+#define cli()
+
+#endif /* SHIM_AVR_INTERRUPT_H_ */
@@ -0,0 +1,65 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<io.h>
+ *
+ * [MODULE]:		<HOST SHIM>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Stand-in for avr/io.h so drivers build on the host>
+ * 					<Registers are plain variables defined in registers.c>
+ *
+ *******************************************************************************/
+#ifndef SHIM_AVR_IO_H_
+#define SHIM_AVR_IO_H_
+
+#include <stdint.h>
+
+#define SHIM_REG8(NAME)		extern volatile uint8_t NAME
+#define SHIM_REG16(NAME)	extern volatile uint16_t NAME
+
+/* USART */
+SHIM_REG8(UDR); SHIM_REG8(UCSRA); SHIM_REG8(UCSRB); SHIM_REG8(UCSRC); SHIM_REG8(UBRRH); SHIM_REG8(UBRRL);
+
+/* SPI */
+SHIM_REG8(SPCR); SHIM_REG8(SPSR); SHIM_REG8(SPDR);
+
+/* TWI */
+SHIM_REG8(TWBR); SHIM_REG8(TWSR); SHIM_REG8(TWAR); SHIM_REG8(TWDR); SHIM_REG8(TWCR);
+
+/* Ports */
+SHIM_REG8(DDRA); SHIM_REG8(DDRB); SHIM_REG8(DDRC); SHIM_REG8(DDRD);
+SHIM_REG8(PORTA); SHIM_REG8(PORTB); SHIM_REG8(PORTC); SHIM_REG8(PORTD);
+SHIM_REG8(PINA); SHIM_REG8(PINB); SHIM_REG8(PINC); SHIM_REG8(PIND);
+
+/* Timers */
+SHIM_REG8(TCCR0); SHIM_REG8(TCNT0); SHIM_REG8(OCR0); SHIM_REG8(TIMSK); SHIM_REG8(TIFR);
+SHIM_REG8(TCCR1A); SHIM_REG8(TCCR1B); SHIM_REG16(TCNT1); SHIM_REG16(OCR1A); SHIM_REG16(OCR1B); SHIM_REG16(ICR1);
+SHIM_REG8(ASSR); SHIM_REG8(TCCR2); SHIM_REG8(TCNT2); SHIM_REG8(OCR2);
+
+/* System, interrupts and ADC */
+SHIM_REG8(SREG); SHIM_REG8(MCUCR); SHIM_REG8(MCUCSR); SHIM_REG8(GICR); SHIM_REG8(GIFR);
+SHIM_REG8(ADMUX); SHIM_REG8(ADCSRA); SHIM_REG16(ADC); SHIM_REG8(SFIOR);
+
+/* Bit numbers, same as the ATmega32 header */
+enum{RXC=7,TXC=6,UDRE=5,FE=4,DOR=3,PE=2,U2X=1,MPCM=0};
+enum{RXCIE=7,TXCIE=6,UDRIE=5,RXEN=4,TXEN=3,UCSZ2=2,RXB8=1,TXB8=0};
+enum{URSEL=7,UMSEL=6,UPM1=5,UPM0=4,USBS=3,UCSZ1=2,UCSZ0=1,UCPOL=0};
+enum{SPIE=7,SPE=6,DORD=5,MSTR=4,CPOL=3,CPHA=2,SPR1=1,SPR0=0};
+enum{SPIF=7,WCOL=6,SPI2X=0};
+enum{TWINT=7,TWEA=6,TWSTA=5,TWSTO=4,TWWC=3,TWEN=2,TWIE=0};
+enum{TWPS1=1,TWPS0=0,TWGCE=0};
+enum{PA0,PA1,PA2,PA3,PA4,PA5,PA6,PA7};
+enum{PB0,PB1,PB2,PB3,PB4,PB5,PB6,PB7};
+enum{PC0,PC1,PC2,PC3,PC4,PC5,PC6,PC7};
+enum{PD0,PD1,PD2,PD3,PD4,PD5,PD6,PD7};
+enum{FOC0=7,WGM00=6,COM01=5,COM00=4,WGM01=3,CS02=2,CS01=1,CS00=0};
+enum{OCIE2=7,TOIE2=6,TICIE1=5,OCIE1A=4,OCIE1B=3,TOIE1=2,OCIE0=1,TOIE0=0};
+enum{OCF2=7,TOV2=6,ICF1=5,OCF1A=4,OCF1B=3,TOV1=2,OCF0=1,TOV0=0};
+enum{COM1A1=7,COM1A0=6,COM1B1=5,COM1B0=4,FOC1A=3,FOC1B=2,WGM11=1,WGM10=0};
+enum{ICNC1=7,ICES1=6,WGM13=4,WGM12=3,CS12=2,CS11=1,CS10=0};
+enum{FOC2=7,WGM20=6,COM21=5,COM20=4,WGM21=3,CS22=2,CS21=1,CS20=0};
+
+#endif /* SHIM_AVR_IO_H_ */
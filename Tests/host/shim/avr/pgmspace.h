@@ -0,0 +1,20 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<pgmspace.h>
+ *
+ * [MODULE]:		<HOST SHIM>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Stand-in for avr/pgmspace.h, flash data is ordinary data>
+ *
+ *******************************************************************************/
+#ifndef SHIM_AVR_PGMSPACE_H_
+#define SHIM_AVR_PGMSPACE_H_
+
+#define PROGMEM
+#define pgm_read_byte(ADDRESS) (*(const unsigned char *)(ADDRESS))
+
+#endif /* SHIM_AVR_PGMSPACE_H_ */
@@ -0,0 +1,32 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<registers.c>
+ *
+ * [MODULE]:		<HOST SHIM>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Storage of the registers declared by the avr/io.h shim>
+ *
+ *******************************************************************************/
+
+#include <avr/io.h>
+
+#undef SHIM_REG8
+#undef SHIM_REG16
+#define SHIM_REG8(NAME)		volatile uint8_t NAME
+#define SHIM_REG16(NAME)	volatile uint16_t NAME
+
+SHIM_REG8(UDR); SHIM_REG8(UCSRA); SHIM_REG8(UCSRB); SHIM_REG8(UCSRC); SHIM_REG8(UBRRH); SHIM_REG8(UBRRL);
+SHIM_REG8(SPCR); SHIM_REG8(SPSR); SHIM_REG8(SPDR);
+SHIM_REG8(TWBR); SHIM_REG8(TWSR); SHIM_REG8(TWAR); SHIM_REG8(TWDR); SHIM_REG8(TWCR);
+SHIM_REG8(DDRA); SHIM_REG8(DDRB); SHIM_REG8(DDRC); SHIM_REG8(DDRD);
+SHIM_REG8(PORTA); SHIM_REG8(PORTB); SHIM_REG8(PORTC); SHIM_REG8(PORTD);
+SHIM_REG8(PINA); SHIM_REG8(PINB); SHIM_REG8(PINC); SHIM_REG8(PIND);
+SHIM_REG8(TCCR0); SHIM_REG8(TCNT0); SHIM_REG8(OCR0); SHIM_REG8(TIMSK); SHIM_REG8(TIFR);
+SHIM_REG8(TCCR1A); SHIM_REG8(TCCR1B); SHIM_REG16(TCNT1); SHIM_REG16(OCR1A); SHIM_REG16(OCR1B); SHIM_REG16(ICR1);
+SHIM_REG8(ASSR); SHIM_REG8(TCCR2); SHIM_REG8(TCNT2); SHIM_REG8(OCR2);
+SHIM_REG8(SREG); SHIM_REG8(MCUCR); SHIM_REG8(MCUCSR); SHIM_REG8(GICR); SHIM_REG8(GIFR);
+SHIM_REG8(ADMUX); SHIM_REG8(ADCSRA); SHIM_REG16(ADC); SHIM_REG8(SFIOR);
@@ -0,0 +1,20 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<atomic.h>
+ *
+ * [MODULE]:		<HOST SHIM>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Stand-in for util/atomic.h, the block runs once>
+ *
+ *******************************************************************************/
+#ifndef SHIM_UTIL_ATOMIC_H_
+#define SHIM_UTIL_ATOMIC_H_
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_BLOCK(TYPE) for(int shim_once=1;shim_once;shim_once=0)
+
+#endif /* SHIM_UTIL_ATOMIC_H_ */
@@ -0,0 +1,20 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<delay.h>
+ *
+ * [MODULE]:		<HOST SHIM>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Stand-in for util/delay.h, delays take no time on the host>
+ *
+ *******************************************************************************/
+#ifndef SHIM_UTIL_DELAY_H_
+#define SHIM_UTIL_DELAY_H_
+
+#define _delay_ms(TIME) ((void)(TIME))
+#define _delay_us(TIME) ((void)(TIME))
+
+#endif /* SHIM_UTIL_DELAY_H_ */
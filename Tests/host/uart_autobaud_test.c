@@ -0,0 +1,262 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<uart_autobaud_test.c>
+ *
+ * [MODULE]:		<HOST TESTS>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Runs UART_autoBaud against a TIMER1 input capture model fed>
+ * 					<with the edges of a character at a known rate. Checks the>
+ * 					<rate and UBRR chosen for the sync character, and that the>
+ * 					<receiver and RXCIE come back after a failed measurement>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+/* Registers first so TIFR below only changes the driver's use of it */
+#include <avr/io.h>
+
+#include "std_types.h"
+#include "common_macros.h"
+
+#include <stdio.h>
+
+/* TIFR flags are cleared by writing one, every access goes through the model */
+static volatile uint8 *TEST_tifr(void);
+#define TIFR (*TEST_tifr())
+
+/* Whole driver so its static run time helper can be used as reference */
+#include "uart.c"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* CPU cycles of one pass of the TIFR polling loop */
+#define TEST_POLL_CYCLES 6
+
+/* TIFR bit the driver never writes, a write is seen by it being cleared */
+#define TEST_MARKER OCF0
+
+/* Cycles before the start bit and the bit time the driver supports */
+#define TEST_IDLE_CYCLES	5000.5
+#define TEST_MIN_BIT_CYCLES	40UL
+
+#define TEST_TIMEOUT_MS 100
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+/* Line edges, falling at even indexes */
+static double g_edges[10];
+static uint8 g_edge_count=0;
+static uint8 g_next_edge=0;
+
+/* TIMER1 model, time in CPU cycles since the measurement started */
+static uint32 g_time=0;
+static uint8 g_flags=0;
+static volatile uint8 g_tifr=0;
+
+static uint16 g_failures=0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	TEST_advance
+ *  [Description] :		This function is responsible for running TIMER1 for a
+ *  					number of cycles, capturing edges of the polarity ICES1
+ *  					selects and setting TOV1 on every wrap
+ *  [Args] :
+ *  [in]				uint32 a_cycles:
+ *  						CPU cycles
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void TEST_advance(uint32 a_cycles){
+	uint32 end=g_time+a_cycles;
+	bool rising;
+
+	if((TCCR1B & 0x07)!=(1<<CS10)){
+		g_time=end;
+		return;
+	}
+	while(g_next_edge<g_edge_count && g_edges[g_next_edge]<=(double)end){
+		rising=(g_next_edge & 1);
+		if(rising==BIT_IS_SET(TCCR1B,ICES1)){
+			ICR1=(uint16)(uint32)g_edges[g_next_edge];
+			g_flags|=(1<<ICF1);
+		}
+		/* An edge of the other polarity is not captured */
+		g_next_edge++;
+	}
+	if((end>>16)!=(g_time>>16)){
+		g_flags|=(1<<TOV1);
+	}
+	g_time=end;
+}
+
+/********************************************************************************
+ *  [Function Name]:	TEST_tifr
+ *  [Description] :		This function is responsible for one access to TIFR, a
+ *  					write done since the last access clears its flags first
+ *  [Args] :
+ *  [in]				None
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			Address the driver reads or writes
+ *********************************************************************************/
+static volatile uint8 *TEST_tifr(void){
+	if(BIT_IS_CLEAR(g_tifr,TEST_MARKER)){
+		g_flags&=~g_tifr;
+	}
+	TEST_advance(TEST_POLL_CYCLES);
+	g_tifr=g_flags | (1<<TEST_MARKER);
+	return &g_tifr;
+}
+
+/********************************************************************************
+ *  [Function Name]:	TEST_line
+ *  [Description] :		This function is responsible for making the edges of an
+ *  					8N1 character at a rate
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						character sent
+ *  					double a_rate:
+ *  						baud rate of the sender
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void TEST_line(uint8 a_data,double a_rate){
+	double bit=(double)F_CPU/a_rate;
+	uint16 frame=(uint16)(0x200 | ((uint16)a_data<<1));
+	uint8 level=1;
+	uint8 i;
+
+	g_edge_count=0;
+	g_next_edge=0;
+	g_time=0;
+	g_flags=0;
+	g_tifr=(1<<TEST_MARKER);
+	/* Start bit, eight data bits LSB first and stop bit */
+	for(i=0;i<10;i++){
+		if(((frame>>i) & 1)!=level){
+			level=(frame>>i) & 1;
+			g_edges[g_edge_count++]=TEST_IDLE_CYCLES+i*bit;
+		}
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	TEST_check
+ *  [Description] :		This function is responsible for counting and printing
+ *  					a failed check
+ *  [Args] :
+ *  [in]				bool a_condition:
+ *  						TRUE when the check passed
+ *  					const char *a_what_Ptr:
+ *  						name of the check
+ *  					double a_rate:
+ *  						rate of the sender
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void TEST_check(bool a_condition,const char *a_what_Ptr,double a_rate){
+	if(!a_condition){
+		printf("FAIL F_CPU=%lu rate=%.0f: %s\n",(unsigned long)F_CPU,a_rate,a_what_Ptr);
+		g_failures++;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	TEST_measure
+ *  [Description] :		This function is responsible for one auto-baud run that
+ *  					must pick a_expected, or fail when it is 0
+ *  [Args] :
+ *  [in]				uint8 a_data:
+ *  						character sent, none when a_rate is 0
+ *  					double a_rate:
+ *  						baud rate of the sender
+ *  					uint32 a_expected:
+ *  						standard rate that must be chosen, 0 for a failure
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void TEST_measure(uint8 a_data,double a_rate,uint32 a_expected){
+	UART_ConfigType config={NORMAL,INTTERRUPT,INTTERRUPT,NO_PARITY,0,'?',W8_BITS,TX_BLOCK,FALSE,0,NO_FLOW_CONTROL};
+	UART_AutoBaudType result={0,0,0};
+	uint8 receiver=(1<<RXEN) | (1<<RXCIE);
+	uint16 ubrr;
+	bool u2x;
+	bool found;
+
+	if(a_rate>0){
+		TEST_line(a_data,a_rate);
+	}
+	else{
+		TEST_line(0xFF,1.0);
+	}
+	UCSRA=0;
+	UCSRB=receiver | (1<<TXEN);
+	TCCR1B=0;
+
+	found=UART_autoBaud(&config,TEST_TIMEOUT_MS,&result);
+	TEST_check((TCCR1B & 0x07)==0,"TIMER1 left running",a_rate);
+
+	if(a_expected==0){
+		TEST_check(!found,"wrong character or silence accepted",a_rate);
+		TEST_check((UCSRB & receiver)==receiver,"receiver and RXCIE not restored after failure",a_rate);
+		return;
+	}
+
+	TEST_check(found,"sync character not measured",a_rate);
+	TEST_check(result.s_baudRate==a_expected,"standard rate chosen",a_rate);
+	TEST_check(config.s_baudRate==a_expected,"rate given to UART_init",a_rate);
+
+	/* UART_init set the divider with the smaller error for the chosen rate */
+	u2x=UART_USE_U2X(a_expected);
+	ubrr=((uint16)UBRRH<<8) | UBRRL;
+	TEST_check(BIT_IS_SET(UCSRA,U2X)==u2x,"U2X",a_rate);
+	TEST_check(ubrr==UART_UBRR_CALC(a_expected,u2x ? 8UL : 16UL),"UBRR",a_rate);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void){
+	uint32 rate;
+	uint16 rates=0;
+	uint8 i;
+
+	for(i=0;i<sizeof(g_standardRates)/sizeof(g_standardRates[0]);i++){
+		rate=g_standardRates[i];
+		if(F_CPU/rate<TEST_MIN_BIT_CYCLES){
+			continue;
+		}
+		rates++;
+		/* Exact sender and senders 2% off still snap to the standard rate */
+		TEST_measure(UART_AUTOBAUD_SYNC,(double)rate,rate);
+		TEST_measure(UART_AUTOBAUD_SYNC,rate*1.02,rate);
+		TEST_measure(UART_AUTOBAUD_SYNC,rate*0.98,rate);
+		/* Bits of unequal length are not the sync character */
+		TEST_measure(0x0F,(double)rate,0);
+	}
+	/* Nothing on the line until the timeout */
+	TEST_measure(0,0.0,0);
+
+	printf("uart_autobaud F_CPU=%lu: %u rates, %u failures\n",(unsigned long)F_CPU,rates,g_failures);
+	return (g_failures==0) ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+/******************************************************************************
+ *
+ * [FILE NAME]:		<uart_baud_test.c>
+ *
+ * [MODULE]:		<HOST TESTS>
+ *
+ * [AUTHOR]:		<Esmail Ahmed>
+ *
+ * [DATE CREATED]:	<17/10/2026>
+ *
+ * [DESCRIPTION]:	<Checks the compile time UBRR/U2X macros of uart.h and the>
+ * 					<run time UART_setBaudRate against the ATmega32 datasheet>
+ * 					<"Examples of UBRR Settings" tables, built once per F_CPU>
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                     			  INCLUDES                                     *
+ *******************************************************************************/
+
+/* Whole driver so its static run time helper can be called */
+#include "uart.c"
+
+#include <stdio.h>
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* One datasheet row, errors in per-mille, UBRR -1 where no setting is given */
+typedef struct
+{
+	uint32	s_clock;
+	uint32	s_baud;
+	sint16	s_ubrr16;
+	uint8	s_error16;
+	sint16	s_ubrr8;
+	uint8	s_error8;
+}TEST_BaudRowType;
+
+/*******************************************************************************
+ *                     			  GLOBAL VARIABLES                             *
+ *******************************************************************************/
+
+static const TEST_BaudRowType g_datasheet[]={
+	{1000000UL,2400,25,2,51,2},		{1000000UL,4800,12,2,25,2},		{1000000UL,9600,6,70,12,2},
+	{1000000UL,14400,3,85,8,35},	{1000000UL,19200,2,85,6,70},	{1000000UL,28800,1,85,3,85},
+	{1000000UL,38400,1,186,2,85},	{1000000UL,57600,0,85,1,85},	{1000000UL,76800,-1,0,1,186},
+	{1000000UL,115200,-1,0,0,85},
+
+	{8000000UL,2400,207,2,416,1},	{8000000UL,4800,103,2,207,2},	{8000000UL,9600,51,2,103,2},
+	{8000000UL,14400,34,8,68,6},	{8000000UL,19200,25,2,51,2},	{8000000UL,28800,16,21,34,8},
+	{8000000UL,38400,12,2,25,2},	{8000000UL,57600,8,35,16,21},	{8000000UL,76800,6,70,12,2},
+	{8000000UL,115200,3,85,8,35},	{8000000UL,230400,1,85,3,85},	{8000000UL,250000,1,0,3,0},
+
+	{11059200UL,2400,287,0,575,0},	{11059200UL,4800,143,0,287,0},	{11059200UL,9600,71,0,143,0},
+	{11059200UL,14400,47,0,95,0},	{11059200UL,19200,35,0,71,0},	{11059200UL,28800,23,0,47,0},
+	{11059200UL,38400,17,0,35,0},	{11059200UL,57600,11,0,23,0},	{11059200UL,76800,8,0,17,0},
+	{11059200UL,115200,5,0,11,0},	{11059200UL,230400,2,0,5,0},	{11059200UL,250000,2,78,5,78},
+
+	{16000000UL,2400,416,1,832,0},	{16000000UL,4800,207,2,416,1},	{16000000UL,9600,103,2,207,2},
+	{16000000UL,14400,68,6,138,1},	{16000000UL,19200,51,2,103,2},	{16000000UL,28800,34,8,68,6},
+	{16000000UL,38400,25,2,51,2},	{16000000UL,57600,16,21,34,8},	{16000000UL,76800,12,2,25,2},
+	{16000000UL,115200,8,35,16,21},	{16000000UL,230400,3,85,8,35},	{16000000UL,250000,3,0,7,0},
+};
+
+static uint16 g_failures=0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/********************************************************************************
+ *  [Function Name]:	TEST_check
+ *  [Description] :		This function is responsible for counting and printing
+ *  					a failed check
+ *  [Args] :
+ *  [in]				bool a_condition:
+ *  						TRUE when the check passed
+ *  					const char *a_what_Ptr:
+ *  						name of the check
+ *  					uint32 a_baud:
+ *  						baud rate of the row
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			None
+ *********************************************************************************/
+static void TEST_check(bool a_condition,const char *a_what_Ptr,uint32 a_baud){
+	if(!a_condition){
+		printf("FAIL F_CPU=%lu baud=%lu: %s\n",(unsigned long)F_CPU,(unsigned long)a_baud,a_what_Ptr);
+		g_failures++;
+	}
+}
+
+/********************************************************************************
+ *  [Function Name]:	TEST_near
+ *  [Description] :		This function is responsible for comparing an error in
+ *  					per-mille, the macro truncates and the datasheet rounds
+ *  [Args] :
+ *  [in]				uint32 a_value:
+ *  						error from the macro
+ *  					uint8 a_datasheet:
+ *  						error from the datasheet
+ *  [out]				None
+ *  [in/out]			None
+ *  [Returns]			TRUE when they differ by at most one
+ *********************************************************************************/
+static bool TEST_near(uint32 a_value,uint8 a_datasheet){
+	return (a_value+1>=a_datasheet) && (a_value<=(uint32)a_datasheet+1);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void){
+	const TEST_BaudRowType *row_Ptr;
+	uint32 baud;
+	uint32 error16;
+	uint32 error8;
+	uint32 error;
+	uint16 ubrr;
+	uint16 rows=0;
+	bool u2x;
+	uint8 i;
+
+	for(i=0;i<sizeof(g_datasheet)/sizeof(g_datasheet[0]);i++){
+		row_Ptr=&g_datasheet[i];
+		if(row_Ptr->s_clock!=F_CPU){
+			continue;
+		}
+		rows++;
+		baud=row_Ptr->s_baud;
+		error16=UART_BAUD_ERROR(baud,16UL);
+		error8=UART_BAUD_ERROR(baud,8UL);
+
+		/* Both dividers give the datasheet settings */
+		if(row_Ptr->s_ubrr16>=0){
+			TEST_check(UART_UBRR_CALC(baud,16UL)==(uint32)row_Ptr->s_ubrr16,"UBRR with U2X=0",baud);
+			TEST_check(TEST_near(error16,row_Ptr->s_error16),"error with U2X=0",baud);
+		}
+		if(row_Ptr->s_ubrr8>=0){
+			TEST_check(UART_UBRR_CALC(baud,8UL)==(uint32)row_Ptr->s_ubrr8,"UBRR with U2X=1",baud);
+			TEST_check(TEST_near(error8,row_Ptr->s_error8),"error with U2X=1",baud);
+		}
+
+		/* Double speed only when normal speed can not make the rate or is worse */
+		u2x=UART_USE_U2X(baud);
+		if(!UART_NORMAL_VALID(baud)){
+			TEST_check(u2x,"U2X forced when U2X=0 can not make the rate",baud);
+		}
+		else{
+			TEST_check(u2x ? (error8<error16) : (error16<=error8),"U2X gives the smaller error",baud);
+		}
+
+		/* Run time path makes the same choice */
+		UCSRA=0;
+		error=UART_setBaudRate(baud);
+		ubrr=((uint16)UBRRH<<8) | UBRRL;
+		TEST_check(BIT_IS_SET(UCSRA,U2X)==u2x,"UART_setBaudRate U2X",baud);
+		TEST_check(ubrr==UART_UBRR_CALC(baud,u2x ? 8UL : 16UL),"UART_setBaudRate UBRR",baud);
+		TEST_check(error==(u2x ? error8 : error16),"UART_setBaudRate error",baud);
+
+		/* Constants UART_init writes for UART_BAUD_RATE */
+		if(baud==UART_BAUD_RATE){
+			TEST_check(UART_U2X_VALUE==u2x,"UART_U2X_VALUE",baud);
+			TEST_check(((UART_UBRRH_VALUE<<8) | UART_UBRRL_VALUE)==UART_UBRR_CALC(baud,u2x ? 8UL : 16UL),"UART_UBRR_VALUE",baud);
+			TEST_check(UART_BAUD_ERROR_VALUE==(u2x ? error8 : error16),"UART_BAUD_ERROR_VALUE",baud);
+		}
+	}
+
+	TEST_check(rows>0,"no datasheet rows for this F_CPU",0);
+	printf("uart_baud F_CPU=%lu: %u rates, %u failures\n",(unsigned long)F_CPU,rows,g_failures);
+	return (g_failures==0) ? 0 : 1;
+}